@@ -0,0 +1,692 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "hash_table.h"
+#include "flat_hash_table.h"
+#include "concurrent_hash_table.h"
+#include "rcu_hash_table.h"
+
+namespace bm
+{
+namespace ds_hash_table
+{
+
+// number of uint64_t keys whose table roughly fills each level of the cache hierarchy
+constexpr std::size_t L1_KEYS{1024*2};
+constexpr std::size_t L2_KEYS{1024*64};
+constexpr std::size_t L3_KEYS{1024*512};
+constexpr std::size_t DRAM_KEYS{1024*1024*8};
+constexpr std::size_t LOOKUP_BATCH{1024*16};
+
+using chained_set = ds::unordered_set<uint64_t>;
+using flat_set = ds::flat_unordered_set<uint64_t>;
+using std_set = std::unordered_set<uint64_t>;
+using incremental_set = ds::incremental_unordered_set<uint64_t>;
+using map = ds::unordered_map<uint64_t, uint64_t>;
+using small_bucket_map = ds::unordered_map<uint64_t, uint64_t, std::hash<uint64_t>, std::equal_to<uint64_t>,
+                                          ds::small_vector<std::pair<uint64_t, uint64_t>, 1>>;
+using std_map = std::unordered_map<uint64_t, uint64_t>;
+using filtered_set = ds::filtered_unordered_set<uint64_t>;
+
+template<typename Set, typename Key>
+bool setContains(const Set & set, const Key & key) { return set.contains(key); }
+
+inline bool setContains(const std_set & set, uint64_t key) { return 0 != set.count(key); }
+
+template<typename Set>
+bool setRemove(Set & set, uint64_t key) { return set.remove(key); }
+
+inline bool setRemove(std_set & set, uint64_t key) { return 0 != set.erase(key); }
+
+// present keys are odd, absent keys are even: a miss never hits by chance
+inline std::vector<uint64_t> generateKeys(std::size_t count, bool present, unsigned seed = 17)
+{
+    std::mt19937_64 generator{seed};
+    std::vector<uint64_t> keys(count);
+    for (auto & key : keys)
+    {
+        key = present ? (generator() | 1) : (generator() & ~uint64_t{1});
+    }
+    return keys;
+}
+
+template<typename BucketPolicy>
+using policy_set = ds::unordered_set<uint64_t, std::hash<uint64_t>, std::equal_to<uint64_t>, ds::vector<uint64_t>, BucketPolicy>;
+
+enum class KeyDistribution
+{
+    Sequential,
+    Uniform,
+    Strided,
+};
+
+// strided keys share their low 12 bits: the worst case for an unmixed mask
+inline std::vector<uint64_t> generateKeys(std::size_t count, KeyDistribution distribution)
+{
+    std::vector<uint64_t> keys(count);
+    std::mt19937_64 generator{29};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        switch (distribution)
+        {
+            case KeyDistribution::Sequential: keys[i] = i; break;
+            case KeyDistribution::Uniform: keys[i] = generator(); break;
+            case KeyDistribution::Strided: keys[i] = i << 12; break;
+        }
+    }
+    return keys;
+}
+
+using string_set = ds::unordered_set<std::string>;
+using cached_string_set = ds::cached_hash_unordered_set<std::string>;
+using std_string_set = std::unordered_set<std::string>;
+using transparent_string_set = ds::unordered_set<std::string, ds::string_hash, std::equal_to<>>;
+
+constexpr std::size_t STRING_KEYS{1024*1024};
+
+// urls under one long common path: every comparison has to walk the prefix
+inline std::vector<std::string> generatePrefixedKeys(std::size_t count, std::size_t offset = 0)
+{
+    const std::string prefix{"https://example.com/api/v2/tenants/0000000042/projects/0000000007/objects/"};
+    std::vector<std::string> keys(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        keys[i] = prefix + std::to_string(offset + i);
+    }
+    return keys;
+}
+
+using concurrent_set = ds::concurrent_unordered_set<uint64_t>;
+using rcu_set = ds::rcu_unordered_set<uint64_t>;
+
+// the baseline the sharded set replaces: one set behind one global mutex
+class global_lock_set
+{
+public:
+    bool contains(uint64_t key) const
+    {
+        std::lock_guard lock{m_mutex};
+        return m_set.contains(key);
+    }
+
+    bool insert(uint64_t key)
+    {
+        std::lock_guard lock{m_mutex};
+        return m_set.insert(key);
+    }
+
+    bool remove(uint64_t key)
+    {
+        std::lock_guard lock{m_mutex};
+        return m_set.remove(key);
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    chained_set m_set;
+};
+
+template<typename Set, typename Key>
+Set buildSet(const std::vector<Key> & keys)
+{
+    Set set;
+    for (const auto & key : keys)
+    {
+        set.insert(key);
+    }
+    return set;
+}
+
+inline bool setContains(const std_string_set & set, const std::string & key) { return 0 != set.count(key); }
+
+// a non transparent set needs a std::string built from the view on every probe
+inline bool viewContains(const string_set & set, std::string_view key) { return set.contains(std::string{key}); }
+
+inline bool viewContains(const transparent_string_set & set, std::string_view key) { return set.contains(key); }
+
+}//ds_hash_table
+}//bm
+
+template<typename Set>
+void bm_hashSetLookupHit(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto keys{generateKeys(state.range(0), true)};
+    auto set{buildSet<Set>(keys)};
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64{3});
+
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(setContains(set, keys[i]));
+        i = (i + 1 == keys.size()) ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Set>
+void bm_hashSetLookupMiss(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto set{buildSet<Set>(generateKeys(state.range(0), true))};
+    auto misses{generateKeys(std::min<std::size_t>(state.range(0), LOOKUP_BATCH), false)};
+
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(setContains(set, misses[i]));
+        i = (i + 1 == misses.size()) ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// fills an empty table up to the requested size, rehashes included
+template<typename Set>
+void bm_hashSetInsert(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto keys{generateKeys(state.range(0), true)};
+
+    for (auto _ : state)
+    {
+        Set set;
+        for (auto key : keys)
+        {
+            benchmark::DoNotOptimize(set.insert(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// same as bm_hashSetInsert, with the final size reserved up front
+template<typename Set>
+void bm_hashSetReserveInsert(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto keys{generateKeys(state.range(0), true)};
+
+    for (auto _ : state)
+    {
+        Set set;
+        set.reserve(keys.size());
+        for (auto key : keys)
+        {
+            benchmark::DoNotOptimize(set.insert(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// times each insert on its own to expose the rehash stalls hidden by the mean
+template<typename Set>
+void bm_hashSetInsertLatency(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    using clock = std::chrono::steady_clock;
+    auto keys{generateKeys(state.range(0), true)};
+    std::vector<double> latencies(keys.size());
+
+    for (auto _ : state)
+    {
+        Set set;
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            auto start{clock::now()};
+            benchmark::DoNotOptimize(set.insert(keys[i]));
+            latencies[i] = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        }
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p){ return latencies[static_cast<std::size_t>(p * (latencies.size() - 1))]; };
+    state.counters["p50_ns"] = percentile(0.5);
+    state.counters["p99_ns"] = percentile(0.99);
+    state.counters["p999_ns"] = percentile(0.999);
+    state.counters["max_ns"] = latencies.back();
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template<typename Set>
+void bm_hashSetErase(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto keys{generateKeys(state.range(0), true)};
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto set{buildSet<Set>(keys)};
+        state.ResumeTiming();
+
+        for (auto key : keys)
+        {
+            benchmark::DoNotOptimize(setRemove(set, key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// args: {table size, KeyDistribution}
+template<typename Set>
+void bm_hashSetPolicyLookup(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto keys{generateKeys(state.range(0), static_cast<KeyDistribution>(state.range(1)))};
+    auto set{buildSet<Set>(keys)};
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64{3});
+
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(setContains(set, keys[i]));
+        i = (i + 1 == keys.size()) ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Set>
+void bm_stringSetInsert(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto keys{generatePrefixedKeys(state.range(0))};
+
+    for (auto _ : state)
+    {
+        Set set;
+        for (const auto & key : keys)
+        {
+            benchmark::DoNotOptimize(set.insert(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// args: {table size, hit}: a miss shares the prefix with every stored key
+template<typename Set>
+void bm_stringSetLookup(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto keys{generatePrefixedKeys(state.range(0))};
+    auto set{buildSet<Set>(keys)};
+    auto probes{state.range(1) ? std::move(keys) : generatePrefixedKeys(state.range(0), state.range(0))};
+    std::shuffle(probes.begin(), probes.end(), std::mt19937_64{3});
+
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(setContains(set, probes[i]));
+        i = (i + 1 == probes.size()) ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// probes are views into one buffer, like keys parsed out of a network packet
+template<typename Set>
+void bm_stringSetViewLookup(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto keys{generatePrefixedKeys(state.range(0))};
+    auto set{buildSet<Set>(keys)};
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64{3});
+
+    std::string buffer;
+    std::vector<std::pair<std::size_t, std::size_t>> spans;
+    for (const auto & key : keys)
+    {
+        spans.emplace_back(buffer.size(), key.size());
+        buffer += key;
+    }
+
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        std::string_view probe{buffer.data() + spans[i].first, spans[i].second};
+        benchmark::DoNotOptimize(viewContains(set, probe));
+        i = (i + 1 == spans.size()) ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Map>
+void bm_hashMapLookup(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto keys{generateKeys(state.range(0), true)};
+    Map map;
+    for (auto key : keys)
+    {
+        map.try_emplace(key, key);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64{3});
+
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        auto it{map.find(keys[i])};
+        if constexpr (std::is_pointer_v<decltype(it)>)
+        {
+            benchmark::DoNotOptimize(*it);
+        }
+        else
+        {
+            benchmark::DoNotOptimize(it->second);
+        }
+        i = (i + 1 == keys.size()) ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Map>
+void bm_hashMapTryEmplace(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto keys{generateKeys(state.range(0), true)};
+
+    for (auto _ : state)
+    {
+        Map map;
+        for (auto key : keys)
+        {
+            benchmark::DoNotOptimize(map.try_emplace(key, key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// counting pattern: a few distinct keys updated many times through operator[]
+template<typename Map>
+void bm_hashMapCount(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto distinct{generateKeys(state.range(0), true)};
+    std::vector<uint64_t> stream(LOOKUP_BATCH * 4);
+    std::mt19937_64 generator{5};
+    for (auto & key : stream)
+    {
+        key = distinct[generator() % distinct.size()];
+    }
+
+    for (auto _ : state)
+    {
+        Map map;
+        for (auto key : stream)
+        {
+            ++map[key];
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * stream.size());
+}
+
+/*
+ * Mixed workload shared by all benchmark threads: 90% lookups, 5% inserts
+ * and 5% removals over a key space twice the preloaded size.
+ */
+template<typename Set>
+void bm_hashSetConcurrentMixed(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    static std::unique_ptr<Set> p_set;
+    auto keys{generateKeys(2 * L2_KEYS, true, 17 + state.thread_index())};
+    if (0 == state.thread_index())
+    {
+        p_set = std::make_unique<Set>();
+        for (auto key : generateKeys(2 * L2_KEYS, true))
+        {
+            p_set->insert(key);
+        }
+    }
+
+    std::mt19937_64 generator(state.thread_index());
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        auto key{keys[i]};
+        auto dice{generator() % 20};
+        if (dice > 1)
+        {
+            benchmark::DoNotOptimize(p_set->contains(key));
+        }
+        else if (0 == dice)
+        {
+            benchmark::DoNotOptimize(p_set->insert(key));
+        }
+        else
+        {
+            benchmark::DoNotOptimize(p_set->remove(key));
+        }
+        i = (i + 1 == keys.size()) ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (0 == state.thread_index())
+    {
+        p_set.reset();
+    }
+}
+
+// every thread looks keys up, thread 0 also inserts or removes one key per 1024 lookups
+template<typename Set>
+void bm_hashSetReaderScaling(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    static std::unique_ptr<Set> p_set;
+    auto keys{generateKeys(L2_KEYS, true)};
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(state.thread_index()));
+    auto writes{generateKeys(LOOKUP_BATCH, false)};
+    if (0 == state.thread_index())
+    {
+        p_set = std::make_unique<Set>();
+        for (auto key : keys)
+        {
+            p_set->insert(key);
+        }
+    }
+
+    bool writer{0 == state.thread_index()};
+    std::size_t i{0};
+    std::size_t w{0};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(p_set->contains(keys[i]));
+        i = (i + 1 == keys.size()) ? 0 : i + 1;
+        if (writer && 0 == (i & 1023))
+        {
+            auto key{writes[w++ % writes.size()]};
+            if (!p_set->insert(key))
+            {
+                p_set->remove(key);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (0 == state.thread_index())
+    {
+        p_set.reset();
+    }
+}
+
+// args: {table size, batch size}
+template<typename Set>
+void bm_hashSetContainsBatch(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto keys{generateKeys(state.range(0), true)};
+    auto set{buildSet<Set>(keys)};
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64{3});
+    std::size_t batchSize(state.range(1));
+    std::unique_ptr<bool[]> results{new bool[batchSize]};
+
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        set.contains_batch(keys.data() + i, batchSize, results.get());
+        benchmark::DoNotOptimize(results.get());
+        i = (i + 2 * batchSize > keys.size()) ? 0 : i + batchSize;
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+
+// the same batches looked up one key at a time
+template<typename Set>
+void bm_hashSetContainsLoop(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto keys{generateKeys(state.range(0), true)};
+    auto set{buildSet<Set>(keys)};
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64{3});
+    std::size_t batchSize(state.range(1));
+    std::unique_ptr<bool[]> results{new bool[batchSize]};
+
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        for (std::size_t k = 0; k < batchSize; ++k)
+        {
+            results[k] = set.contains(keys[i + k]);
+        }
+        benchmark::DoNotOptimize(results.get());
+        i = (i + 2 * batchSize > keys.size()) ? 0 : i + batchSize;
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+
+// lookups where only one key in ten is present, the case a filter in front of the buckets is for
+template<typename Set>
+void bm_hashSetLookupMostlyMiss(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    auto present{generateKeys(state.range(0), true)};
+    auto set{buildSet<Set>(present)};
+    auto keys{generateKeys(std::min<std::size_t>(state.range(0), LOOKUP_BATCH), false)};
+    for (std::size_t i = 0; i < keys.size(); i += 10)
+    {
+        keys[i] = present[i];
+    }
+
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(setContains(set, keys[i]));
+        i = (i + 1 == keys.size()) ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// false positive rate of ds::bloom_filter against its size in bits per key
+static void bm_bloomFilterFalsePositiveRate(benchmark::State & state)
+{
+    using namespace bm::ds_hash_table;
+    std::size_t bitsPerKey(state.range(0));
+    auto present{generateKeys(L3_KEYS, true)};
+    auto absent{generateKeys(L3_KEYS, false)};
+    ds::bloom_filter<uint64_t> filter{present.size(), bitsPerKey};
+    for (auto key : present)
+    {
+        filter.insert(key);
+    }
+
+    std::size_t falsePositives{0};
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        falsePositives += filter.contains(absent[i]);
+        i = (i + 1 == absent.size()) ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["fpr"] = static_cast<double>(falsePositives) / state.iterations();
+    state.counters["bits_per_key"] = static_cast<double>(filter.bit_count()) / present.size();
+}
+
+inline void hashTableBatchArgs(benchmark::internal::Benchmark *b)
+{
+    using namespace bm::ds_hash_table;
+    b->ArgNames({"keys", "batch"});
+    for (auto size : {L2_KEYS, L3_KEYS, DRAM_KEYS})
+    {
+        for (auto batch : {64, 1024})
+        {
+            b->Args({static_cast<int64_t>(size), batch});
+        }
+    }
+}
+
+inline void hashTablePolicyArgs(benchmark::internal::Benchmark *b)
+{
+    using namespace bm::ds_hash_table;
+    b->ArgNames({"keys", "distribution"});
+    for (auto size : {L1_KEYS, L3_KEYS})
+    {
+        for (auto distribution : {KeyDistribution::Sequential, KeyDistribution::Uniform, KeyDistribution::Strided})
+        {
+            b->Args({static_cast<int64_t>(size), static_cast<int64_t>(distribution)});
+        }
+    }
+}
+
+inline void hashTableSizes(benchmark::internal::Benchmark *b)
+{
+    using namespace bm::ds_hash_table;
+    b->Arg(L1_KEYS)->Arg(L2_KEYS)->Arg(L3_KEYS)->Arg(DRAM_KEYS)->Unit(benchmark::kNanosecond);
+}
+
+#if defined (RUN_HASH_TABLE_BENCHMARK)
+BENCHMARK_TEMPLATE(bm_hashSetLookupHit, bm::ds_hash_table::chained_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetLookupHit, bm::ds_hash_table::flat_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetLookupHit, bm::ds_hash_table::std_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetLookupMiss, bm::ds_hash_table::chained_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetLookupMiss, bm::ds_hash_table::flat_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetLookupMiss, bm::ds_hash_table::std_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetInsert, bm::ds_hash_table::chained_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetInsert, bm::ds_hash_table::flat_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetInsert, bm::ds_hash_table::std_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetReserveInsert, bm::ds_hash_table::chained_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetReserveInsert, bm::ds_hash_table::flat_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetReserveInsert, bm::ds_hash_table::std_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetInsertLatency, bm::ds_hash_table::chained_set)->Arg(bm::ds_hash_table::L3_KEYS)->Arg(bm::ds_hash_table::DRAM_KEYS)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bm_hashSetInsertLatency, bm::ds_hash_table::incremental_set)->Arg(bm::ds_hash_table::L3_KEYS)->Arg(bm::ds_hash_table::DRAM_KEYS)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bm_hashSetErase, bm::ds_hash_table::chained_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetErase, bm::ds_hash_table::flat_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetErase, bm::ds_hash_table::std_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetPolicyLookup, bm::ds_hash_table::policy_set<ds::prime_bucket_policy>)->Apply(hashTablePolicyArgs);
+BENCHMARK_TEMPLATE(bm_hashSetPolicyLookup, bm::ds_hash_table::policy_set<ds::power_of_two_bucket_policy>)->Apply(hashTablePolicyArgs);
+BENCHMARK_TEMPLATE(bm_hashSetPolicyLookup, bm::ds_hash_table::policy_set<ds::fastrange_bucket_policy>)->Apply(hashTablePolicyArgs);
+BENCHMARK_TEMPLATE(bm_stringSetInsert, bm::ds_hash_table::string_set)->Arg(bm::ds_hash_table::STRING_KEYS)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bm_stringSetInsert, bm::ds_hash_table::cached_string_set)->Arg(bm::ds_hash_table::STRING_KEYS)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bm_stringSetInsert, bm::ds_hash_table::std_string_set)->Arg(bm::ds_hash_table::STRING_KEYS)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bm_stringSetLookup, bm::ds_hash_table::string_set)->Args({bm::ds_hash_table::STRING_KEYS, 1})->Args({bm::ds_hash_table::STRING_KEYS, 0});
+BENCHMARK_TEMPLATE(bm_stringSetLookup, bm::ds_hash_table::cached_string_set)->Args({bm::ds_hash_table::STRING_KEYS, 1})->Args({bm::ds_hash_table::STRING_KEYS, 0});
+BENCHMARK_TEMPLATE(bm_stringSetLookup, bm::ds_hash_table::std_string_set)->Args({bm::ds_hash_table::STRING_KEYS, 1})->Args({bm::ds_hash_table::STRING_KEYS, 0});
+BENCHMARK_TEMPLATE(bm_stringSetViewLookup, bm::ds_hash_table::string_set)->Arg(bm::ds_hash_table::L2_KEYS)->Arg(bm::ds_hash_table::STRING_KEYS);
+BENCHMARK_TEMPLATE(bm_stringSetViewLookup, bm::ds_hash_table::transparent_string_set)->Arg(bm::ds_hash_table::L2_KEYS)->Arg(bm::ds_hash_table::STRING_KEYS);
+BENCHMARK_TEMPLATE(bm_hashMapLookup, bm::ds_hash_table::map)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashMapLookup, bm::ds_hash_table::small_bucket_map)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashMapLookup, bm::ds_hash_table::std_map)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashMapTryEmplace, bm::ds_hash_table::map)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashMapTryEmplace, bm::ds_hash_table::small_bucket_map)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashMapTryEmplace, bm::ds_hash_table::std_map)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashMapCount, bm::ds_hash_table::map)->Arg(1024)->Arg(bm::ds_hash_table::LOOKUP_BATCH);
+BENCHMARK_TEMPLATE(bm_hashMapCount, bm::ds_hash_table::small_bucket_map)->Arg(1024)->Arg(bm::ds_hash_table::LOOKUP_BATCH);
+BENCHMARK_TEMPLATE(bm_hashMapCount, bm::ds_hash_table::std_map)->Arg(1024)->Arg(bm::ds_hash_table::LOOKUP_BATCH);
+BENCHMARK_TEMPLATE(bm_hashSetConcurrentMixed, bm::ds_hash_table::global_lock_set)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_hashSetConcurrentMixed, bm::ds_hash_table::concurrent_set)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_hashSetReaderScaling, bm::ds_hash_table::global_lock_set)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_hashSetReaderScaling, bm::ds_hash_table::concurrent_set)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_hashSetReaderScaling, bm::ds_hash_table::rcu_set)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_hashSetContainsLoop, bm::ds_hash_table::chained_set)->Apply(hashTableBatchArgs);
+BENCHMARK_TEMPLATE(bm_hashSetContainsBatch, bm::ds_hash_table::chained_set)->Apply(hashTableBatchArgs);
+BENCHMARK_TEMPLATE(bm_hashSetContainsBatch, bm::ds_hash_table::filtered_set)->Apply(hashTableBatchArgs);
+BENCHMARK_TEMPLATE(bm_hashSetLookupMostlyMiss, bm::ds_hash_table::chained_set)->Apply(hashTableSizes);
+BENCHMARK_TEMPLATE(bm_hashSetLookupMostlyMiss, bm::ds_hash_table::filtered_set)->Apply(hashTableSizes);
+BENCHMARK(bm_bloomFilterFalsePositiveRate)->ArgName("bits_per_key")->Arg(8)->Arg(10)->Arg(12)->Arg(16);
+#endif
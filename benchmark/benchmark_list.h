@@ -1,9 +1,14 @@
 #pragma once
 #include <list>
 #include <random>
+#include <vector>
 #include <benchmark/benchmark.h>
 #include "list.h"
+#include "pool_allocator.h"
+#include "unrolled_list.h"
+#include "intrusive_list.h"
 #include "collection_tools.hxx"
+#include "merge_sort.h"
 
 namespace bm
 {
@@ -17,6 +22,34 @@ constexpr std::size_t MAX_SIZE{6500};
 
 static_assert(sizeof(uint8_t) == 1);
 
+using pool_list = ds::list<int, ds::pool_allocator<int>>;
+using unrolled_list = ds::unrolled_list<int>;
+
+constexpr std::size_t LRU_ENTRIES{1024*64};
+
+// cache entry as kept by a connection or timer queue, hook included
+struct lru_entry
+{
+    uint64_t key;
+    uint64_t payload[5];
+    ds::intrusive_list_hook hook;
+};
+
+using lru_list = ds::intrusive_list<lru_entry, &lru_entry::hook>;
+
+// the entries touched by the LRU benchmarks, a few of them far more often than the others
+inline std::vector<uint32_t> generateTouches(std::size_t count)
+{
+    std::mt19937 generator{59};
+    std::vector<uint32_t> touches(count);
+    for (auto & touch : touches)
+    {
+        auto hot{generator() % 4 != 0};
+        touch = static_cast<uint32_t>(generator() % (hot ? LRU_ENTRIES / 64 : LRU_ENTRIES));
+    }
+    return touches;
+}
+
 }//ds_list
 }//bm
 
@@ -96,6 +129,263 @@ inline void bm_listStdCopy(benchmark::State & state)
     }
 }
 
+inline void bm_listDsPoolPushBack(benchmark::State & state)
+{
+    bm::ds_list::pool_list l;
+    for (auto _ : state)
+    {
+        l.pushBack(0);
+    }
+}
+
+inline void bm_listDsPoolCopy(benchmark::State & state)
+{
+    auto arr = ts::generate_fix_sized_array<int, bm::ds_list::MAX_SIZE>();
+    bm::ds_list::pool_list l;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::copy(arr.begin(), arr.end(), std::back_inserter(l)));
+    }
+}
+
+// builds and destroys a whole list, so that freed nodes are handed back too
+template<typename List>
+void bm_listBuildDestroy(benchmark::State & state)
+{
+    for (auto _ : state)
+    {
+        List l;
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            l.push_back(static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(l.back());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// full traversal; half of the nodes were replaced after the build, as in a list in use
+template<typename List>
+void bm_listIteration(benchmark::State & state)
+{
+    List l;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        l.push_back(static_cast<int>(i));
+    }
+    for (auto it = l.begin(); it != l.end(); ++it)
+    {
+        it = l.erase(it);
+    }
+    for (int64_t i = 0; i < state.range(0) / 2; ++i)
+    {
+        l.push_back(static_cast<int>(i));
+    }
+
+    for (auto _ : state)
+    {
+        int sum{0};
+        for (auto value : l)
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// walks from the front to a random position, as DsListIteration does, over byte payloads
+template<typename List>
+void bm_listRandomPositionWalk(benchmark::State & state)
+{
+    auto arr = ts::generate_fix_sized_array<uint8_t, bm::ds_list::L1_SIZE>();
+    List l;
+    for (auto value : arr)
+    {
+        l.push_back(value);
+    }
+
+    std::default_random_engine generator;
+    std::uniform_int_distribution<int> distribution{0, bm::ds_list::L1_SIZE-1};
+    for (auto _ : state)
+    {
+        int random_index = distribution(generator);
+        auto it{l.begin()};
+        for (auto i = 0; i < random_index; ++i)
+        {
+            ++it;
+        }
+        benchmark::DoNotOptimize(*it);
+    }
+}
+
+inline std::vector<int> generateSortInput(std::size_t count)
+{
+    std::mt19937 generator{43};
+    std::vector<int> values(count);
+    for (auto & value : values)
+    {
+        value = static_cast<int>(generator());
+    }
+    return values;
+}
+
+// refills the list with the same shuffled values before every sort, outside of the timing
+template<typename List>
+void refill(List & l, const std::vector<int> & values)
+{
+    auto value{values.begin()};
+    for (auto & element : l)
+    {
+        element = *value++;
+    }
+}
+
+template<typename List>
+void bm_listSort(benchmark::State & state)
+{
+    auto values{generateSortInput(state.range(0))};
+    List l;
+    for (auto value : values)
+    {
+        l.push_back(value);
+    }
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        refill(l, values);
+        state.ResumeTiming();
+        l.sort();
+        benchmark::DoNotOptimize(l.front());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// the workaround the in place sort replaces: copy to a vector, sort it and copy back
+inline void bm_listDsSortThroughVector(benchmark::State & state)
+{
+    auto values{generateSortInput(state.range(0))};
+    ds::list<int> l;
+    for (auto value : values)
+    {
+        l.push_back(value);
+    }
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        refill(l, values);
+        state.ResumeTiming();
+        std::vector<int> sorted(l.begin(), l.end());
+        algo::merge_sort(sorted);
+        std::copy(sorted.begin(), sorted.end(), l.begin());
+        benchmark::DoNotOptimize(l.front());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// merges two sorted lists and splits the result back by splicing its second half away
+template<typename List>
+void bm_listMergeSplice(benchmark::State & state)
+{
+    auto values{generateSortInput(2 * state.range(0))};
+    List l1;
+    List l2;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        l1.push_back(values[2 * i]);
+        l2.push_back(values[2 * i + 1]);
+    }
+    l1.sort();
+    l2.sort();
+
+    for (auto _ : state)
+    {
+        l1.merge(l2);
+        auto middle{l1.begin()};
+        std::advance(middle, state.range(0));
+        l2.splice(l2.end(), l1, middle, l1.end());
+        benchmark::DoNotOptimize(l2.front());
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * state.range(0));
+}
+
+// LRU move to front of an entry found by index: the hook is relinked in place
+inline void bm_lruIntrusiveMoveToFront(benchmark::State & state)
+{
+    using namespace bm::ds_list;
+    std::vector<lru_entry> entries(LRU_ENTRIES);
+    lru_list lru;
+    for (auto & entry : entries)
+    {
+        lru.push_back(entry);
+    }
+    auto touches{generateTouches(1024*16)};
+
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        lru.move_to_front(entries[touches[i]]);
+        benchmark::DoNotOptimize(lru.back().key);
+        i = (i + 1 == touches.size()) ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+    lru.clear();
+}
+
+// the same LRU with the entries stored in ds::list nodes: erase and push front copy the entry and allocate
+inline void bm_lruDsListMoveToFront(benchmark::State & state)
+{
+    using namespace bm::ds_list;
+    using entry_list = ds::list<lru_entry>;
+    entry_list lru;
+    std::vector<entry_list::iterator> positions(LRU_ENTRIES, lru.end());
+    for (std::size_t k = 0; k < LRU_ENTRIES; ++k)
+    {
+        lru.pushBack(lru_entry{k, {}, {}});
+        positions[k] = std::prev(lru.end());
+    }
+    auto touches{generateTouches(1024*16)};
+
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        auto touch{touches[i]};
+        auto entry{*positions[touch]};
+        lru.erase(positions[touch]);
+        lru.pushFront(std::move(entry));
+        positions[touch] = lru.begin();
+        benchmark::DoNotOptimize(lru.back().key);
+        i = (i + 1 == touches.size()) ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// the same LRU on std::list relinking with splice
+inline void bm_lruStdListSplice(benchmark::State & state)
+{
+    using namespace bm::ds_list;
+    using entry_list = std::list<lru_entry>;
+    entry_list lru;
+    std::vector<entry_list::iterator> positions(LRU_ENTRIES);
+    for (std::size_t k = 0; k < LRU_ENTRIES; ++k)
+    {
+        lru.push_back(lru_entry{k, {}, {}});
+        positions[k] = std::prev(lru.end());
+    }
+    auto touches{generateTouches(1024*16)};
+
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        lru.splice(lru.begin(), lru, positions[touches[i]]);
+        benchmark::DoNotOptimize(lru.back().key);
+        i = (i + 1 == touches.size()) ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
 inline void bm_listDsIteration(benchmark::State & state)
 {
 }
@@ -143,4 +433,25 @@ BENCHMARK(bm_listDsInsertEnd);
 BENCHMARK(bm_listStdInsertEnd);
 BENCHMARK(bm_listDsCopy);
 BENCHMARK(bm_listStdCopy);
+BENCHMARK(bm_listDsPoolPushBack);
+BENCHMARK(bm_listDsPoolCopy);
+BENCHMARK_TEMPLATE(bm_listBuildDestroy, ds::list<int>)->Arg(1024)->Arg(1024*256);
+BENCHMARK_TEMPLATE(bm_listBuildDestroy, bm::ds_list::pool_list)->Arg(1024)->Arg(1024*256);
+BENCHMARK_TEMPLATE(bm_listBuildDestroy, std::list<int>)->Arg(1024)->Arg(1024*256);
+BENCHMARK_TEMPLATE(bm_listBuildDestroy, bm::ds_list::unrolled_list)->Arg(1024)->Arg(1024*256);
+BENCHMARK_TEMPLATE(bm_listIteration, ds::list<int>)->Arg(1024*16)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_listIteration, bm::ds_list::pool_list)->Arg(1024*16)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_listIteration, std::list<int>)->Arg(1024*16)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_listIteration, bm::ds_list::unrolled_list)->Arg(1024*16)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_listRandomPositionWalk, ds::list<uint8_t>);
+BENCHMARK_TEMPLATE(bm_listRandomPositionWalk, std::list<uint8_t>);
+BENCHMARK_TEMPLATE(bm_listSort, ds::list<int>)->Arg(1024)->Arg(1024*256);
+BENCHMARK_TEMPLATE(bm_listSort, std::list<int>)->Arg(1024)->Arg(1024*256);
+BENCHMARK(bm_listDsSortThroughVector)->Arg(1024)->Arg(1024*256);
+BENCHMARK_TEMPLATE(bm_listMergeSplice, ds::list<int>)->Arg(1024)->Arg(1024*64);
+BENCHMARK_TEMPLATE(bm_listMergeSplice, std::list<int>)->Arg(1024)->Arg(1024*64);
+BENCHMARK(bm_lruIntrusiveMoveToFront);
+BENCHMARK(bm_lruDsListMoveToFront);
+BENCHMARK(bm_lruStdListSplice);
+BENCHMARK_TEMPLATE(bm_listRandomPositionWalk, ds::unrolled_list<uint8_t>);
 #endif
@@ -1,5 +1,7 @@
 #include <benchmark/benchmark.h>
 #include "benchmark_list.h"
 #include "benchmark_vector.h"
+#include "benchmark_hash_table.h"
+#include "benchmark_tree.h"
 
 BENCHMARK_MAIN();
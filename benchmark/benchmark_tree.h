@@ -0,0 +1,177 @@
+#pragma once
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "avl_tree.h"
+#include "btree_set.h"
+
+namespace bm
+{
+namespace ds_tree
+{
+
+using pool_avl_tree = ::pool_avl_tree<int>;
+using btree_set = ds::btree_set<int>;
+
+// distinct keys in a random insertion order
+inline std::vector<int> generateKeys(std::size_t count)
+{
+    std::vector<int> keys(count);
+    std::iota(std::begin(keys), std::end(keys), 0);
+    std::shuffle(std::begin(keys), std::end(keys), std::mt19937{31});
+    return keys;
+}
+
+template<typename Tree>
+Tree buildTree(const std::vector<int> & keys)
+{
+    Tree tree;
+    for (auto key : keys)
+    {
+        tree.insert(key);
+    }
+    return tree;
+}
+
+}//ds_tree
+}//bm
+
+template<typename Tree>
+void bm_treeBuildDestroy(benchmark::State & state)
+{
+    using namespace bm::ds_tree;
+    auto keys{generateKeys(state.range(0))};
+    for (auto _ : state)
+    {
+        Tree tree;
+        for (auto key : keys)
+        {
+            tree.insert(key);
+        }
+        benchmark::DoNotOptimize(tree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template<typename Tree>
+void bm_treeFind(benchmark::State & state)
+{
+    using namespace bm::ds_tree;
+    auto keys{generateKeys(state.range(0))};
+    auto tree{buildTree<Tree>(keys)};
+    std::shuffle(std::begin(keys), std::end(keys), std::mt19937{37});
+
+    std::size_t i{0};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(tree.find(keys[i]));
+        i = (i + 1 == keys.size()) ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Tree>
+void bm_treeIteration(benchmark::State & state)
+{
+    using namespace bm::ds_tree;
+    auto tree{buildTree<Tree>(generateKeys(state.range(0)))};
+    for (auto _ : state)
+    {
+        long sum{0};
+        for (auto value : tree)
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * tree.size());
+}
+
+// loading a sorted dump: n inserts against from_sorted
+template<typename Tree>
+void bm_avlTreeLoadSorted(benchmark::State & state)
+{
+    std::vector<int> keys(state.range(0));
+    std::iota(std::begin(keys), std::end(keys), 0);
+    for (auto _ : state)
+    {
+        Tree tree;
+        for (auto key : keys)
+        {
+            tree.insert(key);
+        }
+        benchmark::DoNotOptimize(tree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template<typename Tree>
+void bm_avlTreeFromSorted(benchmark::State & state)
+{
+    std::vector<int> keys(state.range(0));
+    std::iota(std::begin(keys), std::end(keys), 0);
+    for (auto _ : state)
+    {
+        auto tree{Tree::from_sorted(std::begin(keys), std::end(keys))};
+        benchmark::DoNotOptimize(tree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template<typename Tree>
+void bm_avlTreeFromSortedParallel(benchmark::State & state)
+{
+    std::vector<int> keys(state.range(0));
+    std::iota(std::begin(keys), std::end(keys), 0);
+    for (auto _ : state)
+    {
+        auto tree{Tree::from_sorted_parallel(std::begin(keys), std::end(keys), state.range(1))};
+        benchmark::DoNotOptimize(tree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// a scan of a tree built by from_sorted, whose nodes were allocated in scan order
+template<typename Tree>
+void bm_avlTreeIterationFromSorted(benchmark::State & state)
+{
+    std::vector<int> keys(state.range(0));
+    std::iota(std::begin(keys), std::end(keys), 0);
+    auto tree{Tree::from_sorted(std::begin(keys), std::end(keys))};
+    for (auto _ : state)
+    {
+        long sum{0};
+        for (auto value : tree)
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * tree.size());
+}
+
+#if defined (RUN_TREE_BENCHMARK)
+BENCHMARK_TEMPLATE(bm_treeBuildDestroy, avl_tree<int>)->Arg(1024)->Arg(1024*256);
+BENCHMARK_TEMPLATE(bm_treeBuildDestroy, bm::ds_tree::pool_avl_tree)->Arg(1024)->Arg(1024*256);
+BENCHMARK_TEMPLATE(bm_treeBuildDestroy, std::set<int>)->Arg(1024)->Arg(1024*256);
+BENCHMARK_TEMPLATE(bm_treeBuildDestroy, bm::ds_tree::btree_set)->Arg(1024)->Arg(1024*256);
+BENCHMARK_TEMPLATE(bm_treeFind, avl_tree<int>)->Arg(1024)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_treeFind, bm::ds_tree::pool_avl_tree)->Arg(1024)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_treeFind, std::set<int>)->Arg(1024)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_treeFind, bm::ds_tree::btree_set)->Arg(1024)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_treeFind, std::set<int>)->Arg(1024*1024*16);
+BENCHMARK_TEMPLATE(bm_treeFind, bm::ds_tree::btree_set)->Arg(1024*1024*16);
+BENCHMARK_TEMPLATE(bm_treeIteration, avl_tree<int>)->Arg(1024*16)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_treeIteration, bm::ds_tree::pool_avl_tree)->Arg(1024*16)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_treeIteration, std::set<int>)->Arg(1024*16)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_treeIteration, bm::ds_tree::btree_set)->Arg(1024*16)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_avlTreeLoadSorted, avl_tree<int>)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_avlTreeFromSorted, avl_tree<int>)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_avlTreeFromSorted, bm::ds_tree::pool_avl_tree)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_avlTreeFromSortedParallel, avl_tree<int>)->Args({1024*1024, 1})->Args({1024*1024, 4});
+BENCHMARK_TEMPLATE(bm_avlTreeIterationFromSorted, avl_tree<int>)->Arg(1024*1024);
+BENCHMARK_TEMPLATE(bm_avlTreeIterationFromSorted, bm::ds_tree::pool_avl_tree)->Arg(1024*1024);
+#endif
@@ -13,6 +13,24 @@ inline void bm_vectorDsPushBack(benchmark::State & state)
     }
 }
 
+inline void bm_vectorDsPushBackUint64(benchmark::State & state)
+{
+    ds::vector<uint64_t> v;
+    for (auto _ : state)
+    {
+        v.push_back(0);
+    }
+}
+
+inline void bm_vectorV1DsPushBackUint64(benchmark::State & state)
+{
+    ds_1::vector<uint64_t> v;
+    for (auto _ : state)
+    {
+        v.push_back(0);
+    }
+}
+
 inline void bm_vectorV1DsPushBack(benchmark::State & state)
 {
     ds_1::vector<int> v;
@@ -47,6 +65,8 @@ inline void bm_vectorV1DsPushBackWithReserve(benchmark::State & state)
 #if defined(RUN_VECTOR_BENCHMARK)
 BENCHMARK(bm_vectorDsPushBack);
 BENCHMARK(bm_vectorV1DsPushBack);
+BENCHMARK(bm_vectorDsPushBackUint64);
+BENCHMARK(bm_vectorV1DsPushBackUint64);
 BENCHMARK(bm_vectorV1DsPushBackWithReserve);
 BENCHMARK(bm_vectorDsPushBackWithReserve);
 #endif
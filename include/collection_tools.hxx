@@ -1,3 +1,4 @@
+#include <array>
 #include <numeric>
 #include <algorithm>
 #include <vector>
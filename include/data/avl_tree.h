@@ -5,8 +5,15 @@
 #include <queue>
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <vector>
 
 #include "iterator_facade.h"
+#include "pool_allocator.h"
+#include "trace.h"
 
 template<typename T>
 constexpr std::size_t avg_print_size{1};
@@ -16,49 +23,41 @@ constexpr std::size_t avg_print_size<int>{2};
 
 template<typename T, 
          typename Compare = std::less<T>, 
-         typename Allocator = std::allocator<T>>
+         typename Allocator = std::allocator<T>,
+         typename Trace = ds::null_trace>
 class avl_tree
 {
     struct move_construct_tag{};
     struct copy_construct_tag{};
 
+    /*
+     * Three links, the value and a one byte height: an AVL tree of height
+     * 127 would need more nodes than any memory holds. Nodes do not refer
+     * to the comparator, the tree passes it down where it is needed.
+     */
     struct Node
     {
-        Compare & comparator;
         Node *parent{nullptr};
         Node *left{nullptr};
         Node *right{nullptr};
-        std::size_t height{0};
         T value{};
+        std::int8_t height{0};
 
-        Node(Compare & comp, const T & element, Node *p = nullptr, Node *lt = nullptr, Node *rt = nullptr, std::size_t h = 0) :
-            comparator{comp},
+        Node(const T & element, Node *p = nullptr, Node *lt = nullptr, Node *rt = nullptr, std::int8_t h = 0) :
             parent{p},
             left{lt},
             right{rt},
-            height{h},
-            value{element}
+            value{element},
+            height{h}
         {}
 
-        Node(Compare & comp, T && element, Node *p = nullptr, Node *lt = nullptr, Node *rt = nullptr, std::size_t h = 0) :
-            comparator{comp},
+        Node(T && element, Node *p = nullptr, Node *lt = nullptr, Node *rt = nullptr, std::int8_t h = 0) :
             parent{p},
             left{lt},
             right{rt},
-            height{h},
-            value{std::move(element)}
+            value{std::move(element)},
+            height{h}
         {}
-
-        Node(const Node &) = default;
-        Node(Node &&) = default;
-        Node & operator=(const Node &) = default;
-        Node & operator=(Node &&) = default;
-
-        bool operator==(const Node & rhs) const
-        {
-            return parent == rhs.parent && left == rhs.left && right == rhs.right &&
-                height == height && (!comparator(value, rhs.value) && !comparator(rhs.value, value));
-        }
     };
 
     template<bool>
@@ -75,41 +74,39 @@ class avl_tree
 
         using node_ptr = std::conditional_t<Const, typename avl_tree::const_pointer, typename avl_tree::pointer>;
 
-        node_iterator(avl_tree & tree, Node *node = nullptr) :
-            parent_tree{tree},
-            current_node{node}
+        node_iterator(const avl_tree & tree, node_ptr node = nullptr) :
+            current_node{node},
+            p_tree{&tree}
+        {}
+
+        template<bool C, typename = std::enable_if_t<Const && !C>>
+        node_iterator(const node_iterator<C> & other) :
+            current_node{other.current_node},
+            p_tree{other.p_tree}
         {}
 
         auto & dereference() const{
             return current_node->value;
         }
 
+        // in order steps follow the links and never call the comparator
         void increment() {
-            current_node = parent_tree.next(current_node);
+            current_node = avl_tree::next(current_node);
         }
 
+        // the tree is needed to step back from end() only
         void decrement() {
-            if (nullptr == current_node){
-                current_node = parent_tree.findMax();
-            }
-            current_node = parent_tree.prev(current_node);
+            current_node = (nullptr == current_node) ? avl_tree::findMax(node_ptr{p_tree->m_root})
+                                                     : avl_tree::prev(current_node);
         }
 
         template<bool C>
         bool equals(const node_iterator<C> & other) const{
-            if (nullptr == current_node){ 
-                return nullptr == other.current_node;
-            }
-
-            if (nullptr != other.current_node){
-               return *current_node == *other.current_node;
-            }
-
-            return false;
+            return current_node == other.current_node;
         }
 
         node_ptr current_node{nullptr};
-        avl_tree & parent_tree;
+        const avl_tree *p_tree{nullptr};
     };
 
 public:
@@ -133,14 +130,15 @@ public:
     avl_tree(const Allocator & alloc) : m_allocator{alloc} {}
 
     avl_tree(avl_tree&& rhs) : 
-        m_size{rhs.m_size},
-        m_allocator{rhs.m_allocator},
-        m_comparator{std::move(rhs.m_comparator)}
+        m_size{std::exchange(rhs.m_size, 0)},
+        m_comparator{std::move(rhs.m_comparator)},
+        m_allocator{rhs.m_allocator}
     {
         m_root = std::exchange(rhs.m_root, nullptr);
     }
 
     avl_tree(const avl_tree & rhs) : 
+        m_comparator{rhs.m_comparator},
         m_allocator{rhs.m_allocator}
     {
         constructFromTree(rhs.m_root, copy_construct_tag{});
@@ -148,6 +146,11 @@ public:
 
     avl_tree &operator=(avl_tree&& rhs)
     {
+        if (this == &rhs)
+        {
+            return *this;
+        }
+
         clear();
         m_comparator = std::move(rhs.m_comparator);
         constexpr bool pocma = allocator_traits::propagate_on_container_move_assignment::value;
@@ -155,10 +158,12 @@ public:
             // our allocator type is not sticky
             m_allocator = rhs.m_allocator;
             m_root = std::exchange(rhs.m_root, nullptr);
+            m_size = std::exchange(rhs.m_size, 0);
         }
         else if (m_allocator == rhs.m_allocator){
             // sticky allocator, but equivalent to the other allocator type
             m_root = std::exchange(rhs.m_root, nullptr);
+            m_size = std::exchange(rhs.m_size, 0);
         }
         else{
             // non propagating allocator; non equivalent
@@ -167,33 +172,39 @@ public:
                 rhs.clear();
             }
         }
+        return *this;
     }
 
     avl_tree &operator=(const avl_tree & rhs)
     {
-        clear();
-        m_comparator = rhs.m_comparator;
+        if (this != &rhs)
+        {
+            clear();
+            m_comparator = rhs.m_comparator;
 
-        constexpr bool pocca = allocator_traits::propagate_on_container_copy_assignment::value;
-        if constexpr (pocca){
-            m_allocator = rhs.m_allocator;
-        }
+            constexpr bool pocca = allocator_traits::propagate_on_container_copy_assignment::value;
+            if constexpr (pocca){
+                m_allocator = rhs.m_allocator;
+            }
 
-        constructFromTree(rhs.m_root, copy_construct_tag{});
+            constructFromTree(rhs.m_root, copy_construct_tag{});
+        }
+        return *this;
     }
 
     void swap(avl_tree & rhs) {
         constexpr bool pocs = allocator_traits::propagate_on_container_swap::value;
         using std::swap;
         swap(m_comparator, rhs.m_comparator);
-        swap(m_size, rhs.m_size);
 
         if constexpr (pocs) {
             swap(m_allocator, rhs.m_allocator);
             swap(m_root, rhs.m_root);
+            swap(m_size, rhs.m_size);
         }
         else if (m_allocator == rhs.m_allocator) {
             swap(m_root, rhs.m_root);
+            swap(m_size, rhs.m_size);
         }
         else {
             auto temp = std::move(*this);
@@ -204,13 +215,76 @@ public:
 
     ~avl_tree() { clear(); }
 
+    /*
+     * Builds a perfectly balanced tree from [first, last), which must be sorted
+     * and free of duplicates under Compare: O(n), without a comparison or a
+     * rotation. Nodes are allocated in order, so a pool allocator lays them
+     * out in the order a scan visits them.
+     */
+    template<typename ForwardIt>
+    static avl_tree from_sorted(ForwardIt first, ForwardIt last, const Allocator & alloc = Allocator{})
+    {
+        avl_tree tree(alloc);
+        auto count{static_cast<std::size_t>(std::distance(first, last))};
+        tree.m_root = tree.buildFromSorted(first, count, nullptr);
+        return tree;
+    }
+
+    /*
+     * from_sorted with the subtrees built on up to threads threads. The nodes
+     * are allocated up front by the calling thread, so the allocator does not
+     * need to be thread safe; only its construct runs concurrently.
+     */
+    template<typename RandomIt>
+    static avl_tree from_sorted_parallel(RandomIt first, RandomIt last,
+                                         std::size_t threads = std::thread::hardware_concurrency(),
+                                         const Allocator & alloc = Allocator{})
+    {
+        static_assert(std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<RandomIt>::iterator_category>,
+                      "avl_tree error: from_sorted_parallel needs random access iterators");
+
+        avl_tree tree(alloc);
+        auto count{static_cast<std::size_t>(last - first)};
+        std::vector<pointer> nodes(count);
+        std::vector<char> constructed(count, 0);
+        std::size_t allocated{0};
+        try
+        {
+            for (; allocated < count; ++allocated)
+            {
+                nodes[allocated] = allocator_traits::allocate(tree.m_allocator, 1);
+            }
+            // 2^depth subtrees are built at the same time
+            std::size_t depth{0};
+            for (; (std::size_t{1} << depth) < threads; ++depth)
+            {}
+            tree.constructRange(first, nodes, constructed, 0, count, nullptr, depth);
+        }
+        catch (...)
+        {
+            for (std::size_t i = 0; i < allocated; ++i)
+            {
+                if (constructed[i])
+                {
+                    allocator_traits::destroy(tree.m_allocator, nodes[i]);
+                }
+                allocator_traits::deallocate(tree.m_allocator, nodes[i], 1);
+            }
+            throw;
+        }
+
+        tree.m_root = rangeRoot(nodes, 0, count);
+        tree.m_size = count;
+        return tree;
+    }
+
 public:
     iterator begin() noexcept { return iterator(*this, findMin(m_root)); }
-    const_iterator begin() const noexcept { return iterator(*this, findMin(m_root)); }
+    const_iterator begin() const noexcept { return const_iterator(*this, findMin(m_root)); }
     const_iterator cbegin() const noexcept { return begin(); }
     
     iterator end() noexcept { return iterator(*this); }
-    const_iterator end() const noexcept { return iterator(*this); }
+    const_iterator end() const noexcept { return const_iterator(*this); }
     const_iterator cend() const noexcept { return end(); }
 
     iterator find(const_reference element) { return iterator(*this, find(element, m_root, m_comparator)); }
@@ -250,7 +324,8 @@ public:
     
         while (nullptr != p_node)
         {
-            p_node = next(p_node, m_comparator);
+            std::cout << p_node->value << " ";
+            p_node = next(p_node);
         }
         std::cout << "\n";
     }
@@ -262,10 +337,15 @@ public:
     
         while (nullptr != p_node)
         {
-            p_node = prev(p_node, m_comparator);
+            std::cout << p_node->value << " ";
+            p_node = prev(p_node);
         }
+        std::cout << "\n";
 
-        std::cout << "avl_tree::print() root value: " << m_root->value << "\n";
+        if (nullptr != m_root)
+        {
+            std::cout << "avl_tree::print() root value: " << m_root->value << "\n";
+        }
 
         std::cout << "\n";
     }
@@ -273,14 +353,12 @@ public:
 protected:
     template<typename... Args>
     pointer allocate(Args&&... args) {
-        std::cout << "avl_tree::allocate()\n";
         pointer p = allocator_traits::allocate(m_allocator, 1);
         try{
-            std::cout << "avl_tree::allocate() constructing object in allocated memory\n";
             allocator_traits::construct(m_allocator, p, std::forward<Args>(args)...);
         }
         catch(...){
-            std::cout <<"avl_tree::allocate() exception catched\n";
+            trace("avl_tree::allocate", "construction failed");
             allocator_traits::deallocate(m_allocator, p, 1);
             p = nullptr;
             throw;
@@ -308,19 +386,16 @@ protected:
     }
 
     void updateHeight(pointer & p_node) {
-        p_node->height = std::max(height(p_node->left), height(p_node->right)) + 1;
-        std::cout << "avl_tree::updateHeight() node value: " << p_node->value << "; height: " << p_node->height <<"\n";
+        p_node->height = static_cast<std::int8_t>(std::max(height(p_node->left), height(p_node->right)) + 1);
     }
 
     void balance(pointer & p_node){
-        std::cout << "avl_tree::balance()\n";
         if (nullptr == p_node){
             return;
         }
 
-        std::cout << "avl_tree::balance() current node value: " << p_node->value << "\n";
         if (height(p_node->left) - height(p_node->right) > MAX_ALLOWED_IMBALANCE){
-            std::cout << "avl_tree::balance() left side is unbalanced\n";
+            trace("avl_tree::balance", "left side unbalanced, value and height", ds::trace_value(p_node->value), p_node->height);
             if (height(p_node->left->left) >= height(p_node->left->right)) {
                 rotateWithLeftChild(p_node);
             }
@@ -329,7 +404,7 @@ protected:
             }
         }
         else if (height(p_node->right) - height(p_node->left) > MAX_ALLOWED_IMBALANCE){
-            std::cout << "avl_tree::balance() right side is unbalanced\n";
+            trace("avl_tree::balance", "right side unbalanced, value and height", ds::trace_value(p_node->value), p_node->height);
             if (height(p_node->right->right) >= height(p_node->right->left)) {
                 rotateWithRightChild(p_node);
             }
@@ -351,11 +426,8 @@ protected:
 
     void rotateWithLeftChild(pointer & p_k2)
     {
-        std::cout << "avl_tree::rotateWithLeftChild()\n";
         pointer p_k1 = p_k2->left;
-        if (nullptr != p_k1){
-            std::cout << "avl_tree::rotateWithRightChild() k2 = " << p_k2->value << " k1 = " << p_k1->value << "\n";
-        }
+        trace("avl_tree::rotateWithLeftChild", "k2 and k1 values", ds::trace_value(p_k2->value), ds::trace_value(p_k1->value));
         p_k2->left = p_k1->right;
         updateParent(p_k2->left, p_k2);
         updateParent(p_k1, p_k2->parent);
@@ -370,9 +442,7 @@ protected:
     void rotateWithRightChild(pointer & p_k1)
     {
         pointer p_k2 = p_k1->right;
-        if (nullptr != p_k2){
-            std::cout << "avl_tree::rotateWithRightChild() k1 = " << p_k1->value << " k2 = " << p_k2->value << "\n";
-        }
+        trace("avl_tree::rotateWithRightChild", "k1 and k2 values", ds::trace_value(p_k1->value), ds::trace_value(p_k2->value));
         p_k1->right = p_k2->left;
         updateParent(p_k1->right, p_k1);
         updateParent(p_k2, p_k1->parent);
@@ -386,23 +456,22 @@ protected:
 
     void doubleRotateWithLeftChild(pointer & p_k3)
     {
-        std::cout << "avl_tree::doubleRotateWithLeftChild()\n";
+        trace("avl_tree::doubleRotateWithLeftChild", "k3 value", ds::trace_value(p_k3->value));
         rotateWithRightChild(p_k3->left);
         rotateWithLeftChild(p_k3);
     }
 
     void doubleRotateWithRightChild(pointer & p_k1)
     {
-        std::cout << "avl_tree::doubleRotateWithRightChild()\n";
+        trace("avl_tree::doubleRotateWithRightChild", "k1 value", ds::trace_value(p_k1->value));
         rotateWithLeftChild(p_k1->right);
         rotateWithRightChild(p_k1);
     }
 
     template<typename U> 
     void insert(U && element, pointer p_parent, pointer & p_node){
-        std::cout << "avl_tree::insert()  " << element << "\n";
-
         if (nullptr == p_node){
+            trace("avl_tree::insert", "new node, value and size", ds::trace_value(element), m_size);
             allocateNode(p_node, std::forward<U>(element), p_parent);
         }
         else if (m_comparator(element, p_node->value)) {
@@ -413,8 +482,6 @@ protected:
         }
 
         balance(p_node);
-        std::cout << "avl_tree::insert() node value: " << p_node->value 
-                  << "; height: " << p_node->height << "\n";
     }
 
     bool contains(const_reference element, pointer p_node) const
@@ -425,48 +492,6 @@ protected:
     template<typename P>
     static P parent(P p_node) { return (nullptr == p_node) ? nullptr : p_node->parent; }
 
-    // navigateToAncestor will always go on the path from the current node to root
-    template<typename P, typename Comparator>
-    static P navigateToAncestor(P p_node, Comparator & comparator, bool negate)
-    {
-        P p_ancestor{p_node};
-
-        static auto comp = [&comparator] (const auto & lhs, const auto & rhs, bool negate){
-            return negate ? !(comparator(lhs, rhs)) : (comparator(lhs, rhs));
-        };
-
-        do {
-            p_ancestor = parent(p_ancestor);
-            if (nullptr == p_ancestor){
-                break;
-            }
-            std::cout << "avl_tree::navigateToAncestor() parent: " << p_ancestor->value << "\n";
-        }
-        while (comp(p_ancestor->value, p_node->value, negate));
-
-        if (nullptr != p_ancestor){
-            std::cout << "avl_tree::navigateToAncestor() found: " << p_ancestor->value << "\n";
-        }
-        else
-        {
-            std::cout << "avl_tree::smallestLargestAncestor() null ancestor found\n";
-        }
-
-        return p_ancestor;
-    }
-
-    template<typename P, typename Comparator>
-    static P nextBiggerParent(P p_node, Comparator & comparator)
-    {
-        return navigateToAncestor(p_node, comparator, false);
-    }
-
-    template<typename P, typename Comparator>
-    static P prevSmallerParent(P p_node, Comparator & comparator)
-    {
-        return navigateToAncestor(p_node, comparator, true);
-    }
-
     template<typename P, typename Comparator>
     static P find(const_reference element, P p_node, const Comparator & comparator)
     {
@@ -489,7 +514,6 @@ protected:
        while (nullptr != p_node) 
        {
            if (nullptr == p_node->left){
-               std::cout << "avl_tree::findMin() found: " << p_node->value << "\n";
                return p_node;
            }
            p_node = p_node->left;
@@ -505,87 +529,94 @@ protected:
             if (nullptr != p_node->right){
                 return findMax(p_node->right);
             }
-               std::cout << "avl_tree::findMax() found: " << p_node->value << "\n";
             return p_node;
         }
         return p_node;
     }
 
 
-    template<typename P, typename Comparator>
-    static P next(P p_node, Comparator & comparator){
+    // the smallest node of the right subtree, else the first ancestor reached from its left subtree:
+    // a full scan crosses every link twice, O(1) amortized per step
+    template<typename P>
+    static P next(P p_node){
         if (nullptr == p_node)
         {
             return nullptr;
         }
-        // 1. go to the smallest element of the right subtree
-        std::cout << "avl_tree::next() current node: " << p_node->value << "\n";
-        P p_next{nullptr};
-        if (p_next = findMin(p_node->right); nullptr == p_next)
+
+        if (nullptr != p_node->right)
+        {
+            return findMin(P{p_node->right});
+        }
+
+        P p_parent{p_node->parent};
+        while (nullptr != p_parent && p_node == p_parent->right)
         {
-            // 2. go to the smallest Ancestor larger than the current node
-            p_next = nextBiggerParent(p_node, comparator);
+            p_node = p_parent;
+            p_parent = p_parent->parent;
         }
-        return p_next;
+        return p_parent;
     }
 
-    template<typename P, typename Comparator>
-    static P prev(P p_node, Comparator & comparator){
+    template<typename P>
+    static P prev(P p_node){
         if (nullptr == p_node)
         {
             return nullptr;
         }
-        // 1. go to largest element of the left subtree
-        P p_prev{nullptr};
-        std::cout << "avl_tree::prev() current node: " << p_node->value << "\n";
-        if (p_prev = findMax(p_node->left); nullptr == p_prev)
+
+        if (nullptr != p_node->left)
+        {
+            return findMax(P{p_node->left});
+        }
+
+        P p_parent{p_node->parent};
+        while (nullptr != p_parent && p_node == p_parent->left)
         {
-            // 2. go to the prev smaller parent
-            p_prev = prevSmallerParent(p_node, comparator);
+            p_node = p_parent;
+            p_parent = p_parent->parent;
         }
-        return p_prev;
+        return p_parent;
     }
 
+   // unlinks the smallest node under p_node and rebalances the path to it
    pointer removeMin(pointer & p_node)
    {
-       if (nullptr != p_node)
+       if (nullptr == p_node)
        {
-           if (nullptr != p_node->left){
-               return removeMin(p_node->left);
-           }
-           else{
-               pointer min_node = p_node;
-               p_node = min_node->right;
-               p_node->parent = min_node->parent;
-               min_node->right = nullptr;
-               return min_node;
-           }
+           return nullptr;
        }
 
-       balance(p_node);
-       return nullptr;
+       if (nullptr != p_node->left){
+           pointer min_node = removeMin(p_node->left);
+           balance(p_node);
+           return min_node;
+       }
+
+       pointer min_node = p_node;
+       p_node = min_node->right;
+       updateParent(p_node, min_node->parent);
+       min_node->right = nullptr;
+       return min_node;
    }
 
    void remove(const_reference x, pointer & p_node)
    {
-       std::cout << "avl_tree::remove() element: " << x <<"\n";
        if (nullptr == p_node) {
            return;
        }
 
        if (m_comparator(x, p_node->value))
        {
-           std::cout << "avl_tree::remove() element is smaller than current value " << p_node->value << "\n";
            remove(x, p_node->left);
        }
        else if (m_comparator(p_node->value, x))
        {
-           std::cout << "avl_tree::remove() element is bigger than current value " << p_node->value << "\n";
            remove(x, p_node->right);
        }
        else //element found
        {
-           std::cout << "avl_tree::remove() element is equal to current value " << p_node->value << "\n";
+           trace("avl_tree::remove", "found, value and height", ds::trace_value(x), p_node->height);
            // both children are not null
            pointer removable = p_node;
            if (nullptr != p_node->right && nullptr != p_node->left)
@@ -596,6 +627,8 @@ protected:
                    replacement->parent = removable->parent;
                    replacement->left = removable->left;
                    replacement->right = removable->right;
+                   updateParent(replacement->left, replacement);
+                   updateParent(replacement->right, replacement);
                }
            }
            else {
@@ -613,33 +646,109 @@ protected:
        balance(p_node);
    }
 
-   void constructFromTree(const_pointer rhs_node, pointer & p_node, copy_construct_tag tag)
+   // copies the shape of the other tree, already balanced, node by node
+   template<typename P, typename Tag>
+   void constructFromTree(P rhs_root, Tag tag)
+   {
+       constructFromTree(rhs_root, nullptr, m_root, tag);
+   }
+
+   void constructFromTree(const_pointer rhs_node, pointer p_parent, pointer & p_node, copy_construct_tag tag)
    {
        if (nullptr == rhs_node){
            return;
        }
-       allocateNode(p_node, rhs_node->value, rhs_node->parent);
-       constructFromTree(rhs_node->left, p_node->left, tag);
-       constructFromTree(rhs_node->right, p_node->right, tag);
-
-       balance(p_node);
+       allocateNode(p_node, rhs_node->value, p_parent);
+       p_node->height = rhs_node->height;
+       constructFromTree(rhs_node->left, p_node, p_node->left, tag);
+       constructFromTree(rhs_node->right, p_node, p_node->right, tag);
    }
 
-   void constructFromTree(pointer rhs_node, pointer & p_node, move_construct_tag tag)
+   void constructFromTree(pointer rhs_node, pointer p_parent, pointer & p_node, move_construct_tag tag)
    {
        if (nullptr == rhs_node){
            return;
        }
-       allocateNode(p_node, std::move(rhs_node->value), rhs_node->parent);
-       constructFromTree(rhs_node->left, p_node->left, tag);
-       constructFromTree(rhs_node->right, p_node->right, tag);
+       allocateNode(p_node, std::move(rhs_node->value), p_parent);
+       p_node->height = rhs_node->height;
+       constructFromTree(rhs_node->left, p_node, p_node->left, tag);
+       constructFromTree(rhs_node->right, p_node, p_node->right, tag);
+   }
 
-       balance(p_node);
+   // height of the tree which from_sorted builds over count values
+   static std::int8_t perfectHeight(std::size_t count)
+   {
+       return static_cast<std::int8_t>(63 - __builtin_clzll(count));
+   }
+
+   // builds the next count values in order: left subtree, its root, right subtree
+   template<typename ForwardIt>
+   pointer buildFromSorted(ForwardIt & first, std::size_t count, pointer p_parent)
+   {
+       if (0 == count){
+           return nullptr;
+       }
+
+       const std::size_t leftCount{count / 2};
+       pointer p_left{buildFromSorted(first, leftCount, nullptr)};
+       pointer p_node{nullptr};
+       try{
+           allocateNode(p_node, *first, p_parent, p_left, nullptr, perfectHeight(count));
+       }
+       catch(...){
+           cleanup(p_left);
+           throw;
+       }
+       ++first;
+       updateParent(p_left, p_node);
+
+       try{
+           p_node->right = buildFromSorted(first, count - leftCount - 1, p_node);
+       }
+       catch(...){
+           cleanup(p_node);
+           throw;
+       }
+       return p_node;
+   }
+
+   // the root from_sorted picks for the values [lo, hi): the middle one, the left half taking the extra value
+   static pointer rangeRoot(const std::vector<pointer> & nodes, std::size_t lo, std::size_t hi)
+   {
+       return (lo == hi) ? nullptr : nodes[lo + (hi - lo) / 2];
+   }
+
+   // every node of [lo, hi) knows its links from the indices alone, so the halves can be built concurrently
+   template<typename RandomIt>
+   void constructRange(RandomIt first, const std::vector<pointer> & nodes, std::vector<char> & constructed,
+                       std::size_t lo, std::size_t hi, pointer p_parent, std::size_t depth)
+   {
+       if (lo == hi){
+           return;
+       }
+
+       const std::size_t mid{lo + (hi - lo) / 2};
+       allocator_traits::construct(m_allocator, nodes[mid], first[mid], p_parent,
+                                   rangeRoot(nodes, lo, mid), rangeRoot(nodes, mid + 1, hi), perfectHeight(hi - lo));
+       constructed[mid] = 1;
+
+       if (0 == depth){
+           constructRange(first, nodes, constructed, lo, mid, nodes[mid], 0);
+           constructRange(first, nodes, constructed, mid + 1, hi, nodes[mid], 0);
+           return;
+       }
+
+       // the future waits for the left half even when the right half throws
+       auto left{std::async(std::launch::async, [&, lo, mid, depth]{
+           constructRange(first, nodes, constructed, lo, mid, nodes[mid], depth - 1);
+       })};
+       constructRange(first, nodes, constructed, mid + 1, hi, nodes[mid], depth - 1);
+       left.get();
    }
 
    template<typename... Args>
    void allocateNode(pointer & p_node, Args&&... args){
-       p_node = allocate(m_comparator, std::forward<Args>(args)...);
+       p_node = allocate(std::forward<Args>(args)...);
        if (nullptr != p_node){
            ++m_size;
        }
@@ -647,37 +756,30 @@ protected:
 
    long height(const_pointer p_node)
    {
-       long h =  (nullptr == p_node) ? -1 : p_node->height;
-       std::cout << "avl_tree::height() node height: " << h << "\n";
-       return h;
+       return (nullptr == p_node) ? -1 : p_node->height;
    }
 
-    const_pointer next(const_pointer p_node) const
-    {
-        return next(p_node, m_comparator);
-    }
-
-    pointer next(pointer p_node) 
-    {
-        return next(p_node, m_comparator);
-    }
-
-    const_pointer prev(const_pointer p_node) const
-    {
-        return prev(p_node, m_comparator);
-    }
-
-    pointer prev(pointer p_node) 
-    {
-        return prev(p_node, m_comparator);
-    }
-
 protected:
    static constexpr long MAX_ALLOWED_IMBALANCE{1};
 
 private:
+    // compiled out unless the Trace policy is enabled
+    static void trace([[maybe_unused]] const char *p_where, [[maybe_unused]] const char *p_what,
+                      [[maybe_unused]] std::int64_t first = 0, [[maybe_unused]] std::int64_t second = 0)
+    {
+        if constexpr (Trace::enabled)
+        {
+            Trace::record({p_where, p_what, first, second});
+        }
+    }
+
     size_type m_size{0};
     Compare m_comparator{};
     node *m_root{nullptr};
     node_allocator m_allocator{};
 };
+
+// nodes carved one after the other from the chunks of a ds::pool_allocator:
+// an insert is a pointer bump and neighbouring nodes share cache lines
+template<typename T, typename Compare = std::less<T>, typename Trace = ds::null_trace>
+using pool_avl_tree = avl_tree<T, Compare, ds::pool_allocator<T>, Trace>;
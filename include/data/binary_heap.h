@@ -4,7 +4,9 @@
 #include <algorithm>
 #include <vector>
 
-template<typename Comparable, typename Comparator = std::less<Comparable>>
+#include "trace.h"
+
+template<typename Comparable, typename Comparator = std::less<Comparable>, typename Trace = ds::null_trace>
 class binary_heap
 {
 public:
@@ -30,6 +32,16 @@ protected:
     void build_heap();
     void percolate_down(std::size_t hole);
 
+    // compiled out unless the Trace policy is enabled
+    static void trace([[maybe_unused]] const char *p_where, [[maybe_unused]] const char *p_what,
+                      [[maybe_unused]] std::int64_t first = 0, [[maybe_unused]] std::int64_t second = 0)
+    {
+        if constexpr (Trace::enabled)
+        {
+            Trace::record({p_where, p_what, first, second});
+        }
+    }
+
 private:
     std::size_t m_current_size{};
     std::vector<Comparable> m_array{};
@@ -37,29 +49,30 @@ private:
 
 };
 
-template<typename Comparable, typename Comparator>
-binary_heap<Comparable, Comparator>::binary_heap(std::size_t capacity) 
+template<typename Comparable, typename Comparator, typename Trace>
+binary_heap<Comparable, Comparator, Trace>::binary_heap(std::size_t capacity) 
 {
     if (capacity < m_array.max_size())
     {
-        m_array.reserve(capacity);
+        m_array.reserve(capacity + 1);
     }
+    m_array.emplace_back(Comparable());
 }
 
-template<typename Comparable, typename Comparator>
-binary_heap<Comparable, Comparator>::binary_heap(const std::vector<Comparable> & items)
+template<typename Comparable, typename Comparator, typename Trace>
+binary_heap<Comparable, Comparator, Trace>::binary_heap(const std::vector<Comparable> & items)
 {
     m_array.emplace_back(Comparable());
     std::copy(std::begin(items), std::end(items), std::back_inserter(m_array));
     build_heap();
 }
 
-template<typename Comparable, typename Comparator> template<typename C>
-void binary_heap<Comparable, Comparator>::insert(C && item)
+template<typename Comparable, typename Comparator, typename Trace> template<typename C>
+void binary_heap<Comparable, Comparator, Trace>::insert(C && item)
 {
     if (m_current_size == m_array.size() - 1)
     {
-        m_array.resize(m_current_size*2 + 1);
+        m_array.resize(m_array.size()*2);
     }
 
     m_array[0] = std::forward<C>(item);
@@ -69,31 +82,26 @@ void binary_heap<Comparable, Comparator>::insert(C && item)
 
     for (; hole > 0 && m_comp(m_array[0], m_array[parentOf(hole)]); hole = parentOf(hole))
     {
-        std::cout << "inserting " << m_array[parentOf(hole)] << " in place of " << m_array[hole] << "\n";
+        trace("binary_heap::insert", "parent moved down, from and to", parentOf(hole), hole);
         m_array[hole] = std::move(m_array[parentOf(hole)]);
     }
 
     m_array[hole] = std::move(m_array[0]);
-    std::cout << "binary_heap::insert() hole: " << hole << "; current_size: " 
-              << m_current_size << "; value " << m_array[hole] << "\n";
+    trace("binary_heap::insert", "hole and current size", hole, m_current_size);
 }
 
-template<typename Comparable, typename Comparator> template<typename UnaryF>
-void binary_heap<Comparable, Comparator>::for_each(UnaryF f)
+template<typename Comparable, typename Comparator, typename Trace> template<typename UnaryF>
+void binary_heap<Comparable, Comparator, Trace>::for_each(UnaryF f)
 {
     std::for_each(std::begin(m_array) + 1, std::begin(m_array) + m_current_size + 1, f);
 }
 
-template<typename Comparable, typename Comparator> 
-void binary_heap<Comparable, Comparator>::percolate_down(std::size_t hole)
+template<typename Comparable, typename Comparator, typename Trace> 
+void binary_heap<Comparable, Comparator, Trace>::percolate_down(std::size_t hole)
 {
     int child{0};
     auto tmp{std::move(m_array[hole])};
 
-    std::cout << "binary_heap::percolate_down() finding a place for " << tmp << "\n";
-    for_each([] (auto val) { std::cout << val << ", " ; });
-    std::cout << "\n";
-
     for(; hole*2 <= m_current_size; hole = child)
     {
         child = hole*2;
@@ -103,11 +111,8 @@ void binary_heap<Comparable, Comparator>::percolate_down(std::size_t hole)
         }
         if (m_comp(m_array[child], tmp))
         {
-            std::cout << "binary_heap::percolate_down() inserting " << m_array[child] 
-                      << " in place of " << m_array[hole] << "\n";
+            trace("binary_heap::percolate_down", "child moved up, from and to", child, hole);
             m_array[hole] = std::move(m_array[child]);
-            for_each([] (auto val) { std::cout << val << ", " ; });
-            std::cout << "\n";
         }
         else
         {
@@ -115,13 +120,11 @@ void binary_heap<Comparable, Comparator>::percolate_down(std::size_t hole)
         }
     }
     m_array[hole] = std::move(tmp);
-    std::cout <<"binary_heap::percolate_down() end of percolation\n";
-    for_each([] (auto val) { std::cout << val << ", " ; });
-    std::cout << "\n";
+    trace("binary_heap::percolate_down", "final hole and current size", hole, m_current_size);
 }
 
-template<typename Comparable, typename Comparator>
-void binary_heap<Comparable, Comparator>::build_heap()
+template<typename Comparable, typename Comparator, typename Trace>
+void binary_heap<Comparable, Comparator, Trace>::build_heap()
 {
     m_current_size = m_array.size();
     m_array.resize(m_current_size*2 + 1);
@@ -132,21 +135,21 @@ void binary_heap<Comparable, Comparator>::build_heap()
     }
 }
 
-template<typename Comparable, typename Comparator>
-void binary_heap<Comparable, Comparator>::pop()
+template<typename Comparable, typename Comparator, typename Trace>
+void binary_heap<Comparable, Comparator, Trace>::pop()
 {
     if (is_empty())
     {
         return;
     }
 
-    std::cout << "binary_heap::pop() removing " << m_array[1] << "\n";
+    trace("binary_heap::pop", "removed value", ds::trace_value(m_array[1]));
     m_array[1] = std::move(m_array[m_current_size--]);
     percolate_down(1);
 }
 
-template<typename Comparable, typename Comparator>
-void binary_heap<Comparable, Comparator>::pop(Comparable & item)
+template<typename Comparable, typename Comparator, typename Trace>
+void binary_heap<Comparable, Comparator, Trace>::pop(Comparable & item)
 {
     if (is_empty())
     {
@@ -157,15 +160,15 @@ void binary_heap<Comparable, Comparator>::pop(Comparable & item)
     pop();
 }
 
-template<typename Comparable, typename Comparator>
-void binary_heap<Comparable, Comparator>::clear()
+template<typename Comparable, typename Comparator, typename Trace>
+void binary_heap<Comparable, Comparator, Trace>::clear()
 {
     m_array.clear();
     m_current_size = 0;
 }
 
-template<typename Comparable, typename Comparator>
-std::optional<std::reference_wrapper<const Comparable>> binary_heap<Comparable, Comparator>::first() const
+template<typename Comparable, typename Comparator, typename Trace>
+std::optional<std::reference_wrapper<const Comparable>> binary_heap<Comparable, Comparator, Trace>::first() const
 {
     if (is_empty())
     {
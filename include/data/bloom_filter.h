@@ -0,0 +1,126 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include "vector.h"
+#include "traits.h"
+
+namespace ds
+{
+
+/*
+ * Split block Bloom filter: every key sets one bit in each of the eight
+ * 32 bit words of a single 32 byte block, so a lookup touches one cache line.
+ * The eight bit positions come from one multiply per word by a fixed odd
+ * salt, which compilers turn into a single vector multiply and compare.
+ * https://github.com/apache/parquet-format/blob/master/BloomFilter.md
+ */
+template<typename Key,
+         typename Hash = std::hash<Key>>
+class bloom_filter
+{
+    static constexpr std::size_t block_words{8};
+
+    struct alignas(32) block
+    {
+        std::uint32_t words[block_words];
+    };
+
+    static constexpr std::uint32_t salts[block_words]{0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                                      0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+public:
+    static constexpr std::size_t default_bits_per_key{10};
+
+    explicit bloom_filter(std::size_t expectedKeys = 1024, std::size_t bitsPerKey = default_bits_per_key)
+    {
+        auto bits{std::max<std::size_t>(expectedKeys * bitsPerKey, 1)};
+        auto blockCount{(bits + 8 * sizeof(block) - 1) / (8 * sizeof(block))};
+        m_blocks.reserve(blockCount);
+        m_blocks.resize(blockCount);
+    }
+
+    template<typename K>
+    void insert(const K & key)
+    {
+        insert_hash(m_hash(key));
+    }
+
+    // false means key was never inserted, true means it probably was
+    template<typename K>
+    bool contains(const K & key) const
+    {
+        return contains_hash(m_hash(key));
+    }
+
+    // for callers that hashed the key already: the same hash must be used to insert and to test
+    void insert_hash(std::size_t hash)
+    {
+        auto h{mix(hash)};
+        std::uint32_t mask[block_words];
+        makeMask(static_cast<std::uint32_t>(h), mask);
+        auto & b{m_blocks[blockIndex(h)]};
+        for (std::size_t i = 0; i < block_words; ++i)
+        {
+            b.words[i] |= mask[i];
+        }
+    }
+
+    bool contains_hash(std::size_t hash) const
+    {
+        auto h{mix(hash)};
+        std::uint32_t mask[block_words];
+        makeMask(static_cast<std::uint32_t>(h), mask);
+        const auto & b{m_blocks[blockIndex(h)]};
+        std::uint32_t missing{0};
+        for (std::size_t i = 0; i < block_words; ++i)
+        {
+            missing |= mask[i] & ~b.words[i];
+        }
+        return 0 == missing;
+    }
+
+    // brings the block of hash towards the cache ahead of a contains_hash
+    void prefetch_hash(std::size_t hash) const
+    {
+        __builtin_prefetch(&m_blocks[blockIndex(mix(hash))]);
+    }
+
+    void clear()
+    {
+        for (auto & b : m_blocks)
+        {
+            b = block{};
+        }
+    }
+
+    std::size_t bit_count() const { return m_blocks.size() * 8 * sizeof(block); }
+
+private:
+    // the caller's hash may be an identity, and its low bits may pick its buckets too
+    static std::uint64_t mix(std::uint64_t h)
+    {
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return h ^ (h >> 31);
+    }
+
+    // the high half picks the block, the low half the bits inside it
+    std::size_t blockIndex(std::uint64_t h) const
+    {
+        return static_cast<std::size_t>(((h >> 32) * m_blocks.size()) >> 32);
+    }
+
+    static void makeMask(std::uint32_t h, std::uint32_t (&mask)[block_words])
+    {
+        for (std::size_t i = 0; i < block_words; ++i)
+        {
+            mask[i] = std::uint32_t{1} << ((h * salts[i]) >> 27);
+        }
+    }
+
+private:
+    Hash m_hash{};
+    ds::vector<block> m_blocks;
+};
+
+}//ds
@@ -0,0 +1,820 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "iterator_facade.h"
+
+namespace ds
+{
+namespace detail
+{
+
+// 32 bit integer keys in std::less order are searched four at a time with SSE2
+template<typename Key, typename Compare>
+constexpr bool btree_simd_search_v = std::is_same_v<Compare, std::less<Key>> &&
+                                     std::is_integral_v<Key> && 4 == sizeof(Key);
+
+// index of the first of the count sorted keys which is not less than key
+template<typename Key, typename Compare>
+std::size_t btreeLowerBound(const Key *p_keys, std::size_t count, const Key & key, const Compare & comp)
+{
+#if defined(__SSE2__)
+    if constexpr (btree_simd_search_v<Key, Compare>)
+    {
+        // flipping the sign bit lets the signed comparison order unsigned keys
+        const __m128i bias{_mm_set1_epi32(std::is_signed_v<Key> ? 0 : static_cast<int>(0x80000000u))};
+        const __m128i probe{_mm_xor_si128(_mm_set1_epi32(static_cast<int>(key)), bias)};
+        std::size_t i{0};
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i block{_mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_keys + i)), bias)};
+            auto less{static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(block, probe))))};
+            if (0xF != less)
+            {
+                return i + static_cast<std::size_t>(__builtin_popcount(less));
+            }
+        }
+        for (; i < count && comp(p_keys[i], key); ++i)
+        {}
+        return i;
+    }
+#endif
+    return static_cast<std::size_t>(std::lower_bound(p_keys, p_keys + count, key, comp) - p_keys);
+}
+
+}//detail
+
+/*
+ * Ordered set of unique keys kept in a B+-tree. Nodes are NodeBytes large,
+ * a few cache lines, so a lookup costs a miss per level of a tree of fan-out
+ * in the tens instead of one per level of a binary tree. Keys live in the
+ * leaves only; inner nodes hold separators, the smallest key of the subtree
+ * on their right. Leaves are linked to their siblings, so iterating or
+ * scanning a range from lower_bound walks arrays of keys.
+ * Inserting or removing invalidates every iterator.
+ * Key must be default constructible and move assignable.
+ */
+template<typename Key,
+         typename Compare = std::less<Key>,
+         typename Allocator = std::allocator<Key>,
+         std::size_t NodeBytes = 256>
+class btree_set
+{
+    static_assert(std::is_default_constructible_v<Key>, "btree_set error: keys must be default constructible");
+
+    struct node_base
+    {
+        std::uint16_t count{0};
+        bool leaf{false};
+    };
+
+public:
+    // a leaf is its count, two sibling links and the keys; an inner node its count, the keys and one more child
+    static constexpr std::size_t leaf_capacity{std::max<std::size_t>(4, (NodeBytes - 3 * sizeof(void*)) / sizeof(Key))};
+    static constexpr std::size_t inner_capacity{std::max<std::size_t>(4, (NodeBytes - 2 * sizeof(void*)) / (sizeof(Key) + sizeof(void*)))};
+
+private:
+    static_assert(leaf_capacity <= UINT16_MAX && inner_capacity <= UINT16_MAX, "btree_set error: node too large");
+
+    // fewest keys a node other than the root holds, low enough for two halves of a split and half enough to merge two
+    static constexpr std::size_t LEAF_MINIMUM{leaf_capacity / 2};
+    static constexpr std::size_t INNER_MINIMUM{(inner_capacity - 1) / 2};
+
+    struct leaf_node : node_base
+    {
+        leaf_node() { this->leaf = true; }
+
+        leaf_node *p_prev{nullptr};
+        leaf_node *p_next{nullptr};
+        Key keys[leaf_capacity];
+    };
+
+    struct inner_node : node_base
+    {
+        Key keys[inner_capacity];
+        node_base *children[inner_capacity + 1]{};
+    };
+
+    // what a node which split hands to its parent
+    struct split_result
+    {
+        Key separator{};
+        node_base *p_right{nullptr};
+    };
+
+    class leaf_iterator : public iterator_facade<leaf_iterator, const Key, std::bidirectional_iterator_tag>
+    {
+        friend btree_set;
+        friend iterator_facade<leaf_iterator, const Key, std::bidirectional_iterator_tag>;
+
+    public:
+        leaf_iterator() = default;
+
+    protected:
+        leaf_iterator(const leaf_node *p, std::size_t i) :
+            p_leaf{p},
+            index{i}
+        {}
+
+        bool equals(const leaf_iterator & other) const
+        {
+            return p_leaf == other.p_leaf && index == other.index;
+        }
+
+        const Key & dereference() const
+        {
+            return p_leaf->keys[index];
+        }
+
+        // the end iterator is one past the last key of the last leaf
+        void increment()
+        {
+            if (++index == p_leaf->count && nullptr != p_leaf->p_next)
+            {
+                p_leaf = p_leaf->p_next;
+                index = 0;
+            }
+        }
+
+        void decrement()
+        {
+            if (0 == index)
+            {
+                p_leaf = p_leaf->p_prev;
+                index = p_leaf->count;
+            }
+            --index;
+        }
+
+    private:
+        const leaf_node *p_leaf{nullptr};
+        std::size_t index{0};
+    };
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using leaf_allocator = typename alloc_traits::template rebind_alloc<leaf_node>;
+    using leaf_alloc_traits = std::allocator_traits<leaf_allocator>;
+    using inner_allocator = typename alloc_traits::template rebind_alloc<inner_node>;
+    using inner_alloc_traits = std::allocator_traits<inner_allocator>;
+
+public:
+    using value_type = Key;
+    using key_type = Key;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+    using reference = const value_type&;
+    using const_reference = const value_type&;
+    using iterator = leaf_iterator;
+    using const_iterator = leaf_iterator;
+
+public:
+    btree_set() = default;
+
+    explicit btree_set(const Allocator & alloc) :
+        m_leafAllocator{alloc},
+        m_innerAllocator{alloc}
+    {}
+
+    btree_set(const btree_set & other) :
+        m_comparator{other.m_comparator},
+        m_leafAllocator{leaf_alloc_traits::select_on_container_copy_construction(other.m_leafAllocator)},
+        m_innerAllocator{inner_alloc_traits::select_on_container_copy_construction(other.m_innerAllocator)}
+    {
+        if (nullptr == other.m_root)
+        {
+            return;
+        }
+
+        try
+        {
+            copyNode(other.m_root, m_root);
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+        m_size = other.m_size;
+    }
+
+    btree_set(btree_set && other) noexcept :
+        m_comparator{std::move(other.m_comparator)},
+        m_leafAllocator{std::move(other.m_leafAllocator)},
+        m_innerAllocator{std::move(other.m_innerAllocator)}
+    {
+        steal(other);
+    }
+
+    btree_set & operator=(const btree_set & other)
+    {
+        if (this != &other)
+        {
+            auto copy{other};
+            swap(copy);
+        }
+        return *this;
+    }
+
+    btree_set & operator=(btree_set && other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        clear();
+        m_comparator = std::move(other.m_comparator);
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            m_leafAllocator = std::move(other.m_leafAllocator);
+            m_innerAllocator = std::move(other.m_innerAllocator);
+            steal(other);
+        }
+        else if (m_leafAllocator == other.m_leafAllocator)
+        {
+            steal(other);
+        }
+        else
+        {
+            for (auto & key : other)
+            {
+                insert(std::move(const_cast<Key&>(key)));
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~btree_set() { clear(); }
+
+    void swap(btree_set & other) noexcept
+    {
+        using std::swap;
+        swap(m_comparator, other.m_comparator);
+        swap(m_leafAllocator, other.m_leafAllocator);
+        swap(m_innerAllocator, other.m_innerAllocator);
+        swap(m_root, other.m_root);
+        swap(m_first, other.m_first);
+        swap(m_last, other.m_last);
+        swap(m_size, other.m_size);
+    }
+
+public:
+    iterator begin() const noexcept { return iterator(m_first, 0); }
+    iterator end() const noexcept { return iterator(m_last, nullptr == m_last ? 0 : m_last->count); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    size_type size() const { return m_size; }
+    bool empty() const { return 0 == m_size; }
+
+    iterator findMin() const { return begin(); }
+    iterator findMax() const { return empty() ? end() : iterator(m_last, m_last->count - 1u); }
+
+    iterator find(const_reference key) const
+    {
+        if (nullptr == m_root)
+        {
+            return end();
+        }
+
+        const auto *p_leaf{findLeaf(key)};
+        auto index{lowerBound(p_leaf, key)};
+        if (index < p_leaf->count && !m_comparator(key, p_leaf->keys[index]))
+        {
+            return iterator(p_leaf, index);
+        }
+        return end();
+    }
+
+    bool contains(const_reference key) const { return end() != find(key); }
+
+    // the first key not less than key: where a range scan starts
+    iterator lower_bound(const_reference key) const
+    {
+        if (nullptr == m_root)
+        {
+            return end();
+        }
+
+        const auto *p_leaf{findLeaf(key)};
+        auto index{lowerBound(p_leaf, key)};
+        if (index == p_leaf->count && nullptr != p_leaf->p_next)
+        {
+            return iterator(p_leaf->p_next, 0);
+        }
+        return iterator(p_leaf, index);
+    }
+
+    // returns false when the key is already in the set
+    bool insert(value_type key)
+    {
+        if (nullptr == m_root)
+        {
+            m_root = m_first = m_last = newLeaf();
+        }
+
+        split_result split;
+        if (!insert(m_root, key, split))
+        {
+            return false;
+        }
+
+        if (nullptr != split.p_right)
+        {
+            auto *p_root{newInner()};
+            p_root->keys[0] = std::move(split.separator);
+            p_root->children[0] = m_root;
+            p_root->children[1] = split.p_right;
+            p_root->count = 1;
+            m_root = p_root;
+        }
+        ++m_size;
+        return true;
+    }
+
+    // returns false when the key is not in the set
+    bool remove(const_reference key)
+    {
+        if (nullptr == m_root || !remove(m_root, key))
+        {
+            return false;
+        }
+
+        --m_size;
+        if (0 == m_root->count)
+        {
+            if (m_root->leaf)
+            {
+                deleteNode(static_cast<leaf_node*>(m_root));
+                m_root = m_first = m_last = nullptr;
+            }
+            else
+            {
+                auto *p_root{static_cast<inner_node*>(m_root)};
+                m_root = p_root->children[0];
+                deleteNode(p_root);
+            }
+        }
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        destroy(m_root);
+        m_root = m_first = m_last = nullptr;
+        m_size = 0;
+    }
+
+    // checks ordering, fill, depth and sibling links of the whole tree
+    bool validate() const
+    {
+        if (nullptr == m_root)
+        {
+            return 0 == m_size && nullptr == m_first && nullptr == m_last;
+        }
+
+        std::size_t leafDepth{0};
+        std::size_t count{0};
+        const leaf_node *p_previous{nullptr};
+        return validate(m_root, nullptr, nullptr, 1, leafDepth, p_previous, count) &&
+               m_last == p_previous && count == m_size;
+    }
+
+private:
+    std::size_t lowerBound(const leaf_node *p_leaf, const Key & key) const
+    {
+        return detail::btreeLowerBound(p_leaf->keys, p_leaf->count, key, m_comparator);
+    }
+
+    // the child of an inner node whose keys range over key
+    std::size_t childIndex(const inner_node *p_inner, const Key & key) const
+    {
+        auto index{detail::btreeLowerBound(p_inner->keys, p_inner->count, key, m_comparator)};
+        if (index < p_inner->count && !m_comparator(key, p_inner->keys[index]))
+        {
+            ++index;
+        }
+        return index;
+    }
+
+    const leaf_node *findLeaf(const Key & key) const
+    {
+        const node_base *p_node{m_root};
+        while (!p_node->leaf)
+        {
+            const auto *p_inner{static_cast<const inner_node*>(p_node)};
+            p_node = p_inner->children[childIndex(p_inner, key)];
+        }
+        return static_cast<const leaf_node*>(p_node);
+    }
+
+    bool insert(node_base *p_node, Key & key, split_result & split)
+    {
+        if (p_node->leaf)
+        {
+            return insertIntoLeaf(static_cast<leaf_node*>(p_node), key, split);
+        }
+
+        auto *p_inner{static_cast<inner_node*>(p_node)};
+        auto index{childIndex(p_inner, key)};
+        split_result childSplit;
+        if (!insert(p_inner->children[index], key, childSplit))
+        {
+            return false;
+        }
+
+        if (nullptr != childSplit.p_right)
+        {
+            insertIntoInner(p_inner, index, childSplit, split);
+        }
+        return true;
+    }
+
+    bool insertIntoLeaf(leaf_node *p_leaf, Key & key, split_result & split)
+    {
+        auto index{lowerBound(p_leaf, key)};
+        if (index < p_leaf->count && !m_comparator(key, p_leaf->keys[index]))
+        {
+            return false;
+        }
+
+        if (leaf_capacity == p_leaf->count)
+        {
+            // the upper half moves to a new right sibling
+            constexpr std::size_t half{leaf_capacity / 2};
+            auto *p_right{newLeaf()};
+            std::move(p_leaf->keys + half, p_leaf->keys + leaf_capacity, p_right->keys);
+            p_right->count = static_cast<std::uint16_t>(leaf_capacity - half);
+            p_leaf->count = static_cast<std::uint16_t>(half);
+
+            p_right->p_prev = p_leaf;
+            p_right->p_next = p_leaf->p_next;
+            (nullptr == p_right->p_next ? m_last : p_right->p_next->p_prev) = p_right;
+            p_leaf->p_next = p_right;
+
+            split.p_right = p_right;
+            if (index > half)
+            {
+                insertKey(p_right, index - half, key);
+            }
+            else
+            {
+                insertKey(p_leaf, index, key);
+            }
+            split.separator = p_right->keys[0];
+            return true;
+        }
+
+        insertKey(p_leaf, index, key);
+        return true;
+    }
+
+    void insertKey(leaf_node *p_leaf, std::size_t index, Key & key)
+    {
+        std::move_backward(p_leaf->keys + index, p_leaf->keys + p_leaf->count, p_leaf->keys + p_leaf->count + 1);
+        p_leaf->keys[index] = std::move(key);
+        ++p_leaf->count;
+    }
+
+    // links the right half of the split child at index, splitting p_inner as well when it is full
+    void insertIntoInner(inner_node *p_inner, std::size_t index, split_result & childSplit, split_result & split)
+    {
+        if (inner_capacity == p_inner->count)
+        {
+            // keys before mid stay, the key at mid moves up, the ones after it move right with their children
+            constexpr std::size_t mid{inner_capacity / 2};
+            auto *p_right{newInner()};
+            std::move(p_inner->keys + mid + 1, p_inner->keys + inner_capacity, p_right->keys);
+            std::copy(p_inner->children + mid + 1, p_inner->children + inner_capacity + 1, p_right->children);
+            p_right->count = static_cast<std::uint16_t>(inner_capacity - mid - 1);
+            p_inner->count = static_cast<std::uint16_t>(mid);
+
+            split.separator = std::move(p_inner->keys[mid]);
+            split.p_right = p_right;
+            if (index > mid)
+            {
+                insertChild(p_right, index - mid - 1, childSplit);
+                return;
+            }
+        }
+        insertChild(p_inner, index, childSplit);
+    }
+
+    void insertChild(inner_node *p_inner, std::size_t index, split_result & childSplit)
+    {
+        std::move_backward(p_inner->keys + index, p_inner->keys + p_inner->count, p_inner->keys + p_inner->count + 1);
+        std::copy_backward(p_inner->children + index + 1, p_inner->children + p_inner->count + 1, p_inner->children + p_inner->count + 2);
+        p_inner->keys[index] = std::move(childSplit.separator);
+        p_inner->children[index + 1] = childSplit.p_right;
+        ++p_inner->count;
+    }
+
+    bool remove(node_base *p_node, const Key & key)
+    {
+        if (p_node->leaf)
+        {
+            auto *p_leaf{static_cast<leaf_node*>(p_node)};
+            auto index{lowerBound(p_leaf, key)};
+            if (index == p_leaf->count || m_comparator(key, p_leaf->keys[index]))
+            {
+                return false;
+            }
+            std::move(p_leaf->keys + index + 1, p_leaf->keys + p_leaf->count, p_leaf->keys + index);
+            --p_leaf->count;
+            return true;
+        }
+
+        auto *p_inner{static_cast<inner_node*>(p_node)};
+        auto index{childIndex(p_inner, key)};
+        if (!remove(p_inner->children[index], key))
+        {
+            return false;
+        }
+
+        if (p_inner->children[index]->count < minimum(p_inner->children[index]))
+        {
+            rebalance(p_inner, index);
+        }
+        return true;
+    }
+
+    static std::size_t minimum(const node_base *p_node)
+    {
+        return p_node->leaf ? LEAF_MINIMUM : INNER_MINIMUM;
+    }
+
+    // refills the child at index, below its minimum, from a sibling or merges it with one
+    void rebalance(inner_node *p_parent, std::size_t index)
+    {
+        auto *p_left{index > 0 ? p_parent->children[index - 1] : nullptr};
+        auto *p_right{index < p_parent->count ? p_parent->children[index + 1] : nullptr};
+        if (nullptr != p_left && p_left->count > minimum(p_left))
+        {
+            borrowFromLeft(p_parent, index);
+        }
+        else if (nullptr != p_right && p_right->count > minimum(p_right))
+        {
+            borrowFromRight(p_parent, index);
+        }
+        else if (nullptr != p_left)
+        {
+            merge(p_parent, index - 1);
+        }
+        else
+        {
+            merge(p_parent, index);
+        }
+    }
+
+    void borrowFromLeft(inner_node *p_parent, std::size_t index)
+    {
+        auto *p_node{p_parent->children[index]};
+        if (p_node->leaf)
+        {
+            auto *p_child{static_cast<leaf_node*>(p_node)};
+            auto *p_left{static_cast<leaf_node*>(p_parent->children[index - 1])};
+            std::move_backward(p_child->keys, p_child->keys + p_child->count, p_child->keys + p_child->count + 1);
+            p_child->keys[0] = std::move(p_left->keys[--p_left->count]);
+            ++p_child->count;
+            p_parent->keys[index - 1] = p_child->keys[0];
+            return;
+        }
+
+        auto *p_child{static_cast<inner_node*>(p_node)};
+        auto *p_left{static_cast<inner_node*>(p_parent->children[index - 1])};
+        std::move_backward(p_child->keys, p_child->keys + p_child->count, p_child->keys + p_child->count + 1);
+        std::copy_backward(p_child->children, p_child->children + p_child->count + 1, p_child->children + p_child->count + 2);
+        p_child->keys[0] = std::move(p_parent->keys[index - 1]);
+        p_child->children[0] = p_left->children[p_left->count];
+        ++p_child->count;
+        p_parent->keys[index - 1] = std::move(p_left->keys[--p_left->count]);
+    }
+
+    void borrowFromRight(inner_node *p_parent, std::size_t index)
+    {
+        auto *p_node{p_parent->children[index]};
+        if (p_node->leaf)
+        {
+            auto *p_child{static_cast<leaf_node*>(p_node)};
+            auto *p_right{static_cast<leaf_node*>(p_parent->children[index + 1])};
+            p_child->keys[p_child->count++] = std::move(p_right->keys[0]);
+            std::move(p_right->keys + 1, p_right->keys + p_right->count, p_right->keys);
+            --p_right->count;
+            p_parent->keys[index] = p_right->keys[0];
+            return;
+        }
+
+        auto *p_child{static_cast<inner_node*>(p_node)};
+        auto *p_right{static_cast<inner_node*>(p_parent->children[index + 1])};
+        p_child->keys[p_child->count] = std::move(p_parent->keys[index]);
+        p_child->children[p_child->count + 1] = p_right->children[0];
+        ++p_child->count;
+        p_parent->keys[index] = std::move(p_right->keys[0]);
+        std::move(p_right->keys + 1, p_right->keys + p_right->count, p_right->keys);
+        std::copy(p_right->children + 1, p_right->children + p_right->count + 1, p_right->children);
+        --p_right->count;
+    }
+
+    // moves the child at index + 1 into the child at index and drops the separator between them
+    void merge(inner_node *p_parent, std::size_t index)
+    {
+        auto *p_node{p_parent->children[index]};
+        if (p_node->leaf)
+        {
+            auto *p_left{static_cast<leaf_node*>(p_node)};
+            auto *p_right{static_cast<leaf_node*>(p_parent->children[index + 1])};
+            std::move(p_right->keys, p_right->keys + p_right->count, p_left->keys + p_left->count);
+            p_left->count += p_right->count;
+            p_left->p_next = p_right->p_next;
+            (nullptr == p_left->p_next ? m_last : p_left->p_next->p_prev) = p_left;
+            deleteNode(p_right);
+        }
+        else
+        {
+            auto *p_left{static_cast<inner_node*>(p_node)};
+            auto *p_right{static_cast<inner_node*>(p_parent->children[index + 1])};
+            p_left->keys[p_left->count] = std::move(p_parent->keys[index]);
+            std::move(p_right->keys, p_right->keys + p_right->count, p_left->keys + p_left->count + 1);
+            std::copy(p_right->children, p_right->children + p_right->count + 1, p_left->children + p_left->count + 1);
+            p_left->count += p_right->count + 1;
+            deleteNode(p_right);
+        }
+
+        std::move(p_parent->keys + index + 1, p_parent->keys + p_parent->count, p_parent->keys + index);
+        std::copy(p_parent->children + index + 2, p_parent->children + p_parent->count + 1, p_parent->children + index + 1);
+        p_parent->children[p_parent->count] = nullptr;
+        --p_parent->count;
+    }
+
+    // copies the subtree of p_source into p_target, appending its leaves to the sibling chain
+    void copyNode(const node_base *p_source, node_base *& p_target)
+    {
+        if (p_source->leaf)
+        {
+            const auto *p_from{static_cast<const leaf_node*>(p_source)};
+            auto *p_leaf{newLeaf()};
+            p_target = p_leaf;
+            std::copy(p_from->keys, p_from->keys + p_from->count, p_leaf->keys);
+            p_leaf->count = p_from->count;
+
+            p_leaf->p_prev = m_last;
+            (nullptr == m_last ? m_first : m_last->p_next) = p_leaf;
+            m_last = p_leaf;
+            return;
+        }
+
+        const auto *p_from{static_cast<const inner_node*>(p_source)};
+        auto *p_inner{newInner()};
+        p_target = p_inner;
+        std::copy(p_from->keys, p_from->keys + p_from->count, p_inner->keys);
+        p_inner->count = p_from->count;
+        for (std::size_t i = 0; i <= p_from->count; ++i)
+        {
+            copyNode(p_from->children[i], p_inner->children[i]);
+        }
+    }
+
+    void steal(btree_set & other) noexcept
+    {
+        m_root = std::exchange(other.m_root, nullptr);
+        m_first = std::exchange(other.m_first, nullptr);
+        m_last = std::exchange(other.m_last, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+    }
+
+    // children of an inner node being copied may still be null
+    void destroy(node_base *p_node) noexcept
+    {
+        if (nullptr == p_node)
+        {
+            return;
+        }
+
+        if (p_node->leaf)
+        {
+            deleteNode(static_cast<leaf_node*>(p_node));
+            return;
+        }
+
+        auto *p_inner{static_cast<inner_node*>(p_node)};
+        for (std::size_t i = 0; i <= p_inner->count; ++i)
+        {
+            destroy(p_inner->children[i]);
+        }
+        deleteNode(p_inner);
+    }
+
+    leaf_node *newLeaf()
+    {
+        return newNode<leaf_node>(m_leafAllocator);
+    }
+
+    inner_node *newInner()
+    {
+        return newNode<inner_node>(m_innerAllocator);
+    }
+
+    template<typename Node, typename NodeAllocator>
+    static Node *newNode(NodeAllocator & allocator)
+    {
+        using traits = std::allocator_traits<NodeAllocator>;
+        auto *p_node{traits::allocate(allocator, 1)};
+        try
+        {
+            traits::construct(allocator, p_node);
+        }
+        catch (...)
+        {
+            traits::deallocate(allocator, p_node, 1);
+            throw;
+        }
+        return p_node;
+    }
+
+    void deleteNode(leaf_node *p_leaf) noexcept
+    {
+        leaf_alloc_traits::destroy(m_leafAllocator, p_leaf);
+        leaf_alloc_traits::deallocate(m_leafAllocator, p_leaf, 1);
+    }
+
+    void deleteNode(inner_node *p_inner) noexcept
+    {
+        inner_alloc_traits::destroy(m_innerAllocator, p_inner);
+        inner_alloc_traits::deallocate(m_innerAllocator, p_inner, 1);
+    }
+
+    // keys of p_node must lie in [p_lower, p_upper), the bounds given by the separators above it
+    bool validate(const node_base *p_node, const Key *p_lower, const Key *p_upper, std::size_t depth,
+                  std::size_t & leafDepth, const leaf_node *& p_previous, std::size_t & count) const
+    {
+        if (m_root != p_node && p_node->count < minimum(p_node))
+        {
+            return false;
+        }
+
+        const Key *p_keys{p_node->leaf ? static_cast<const leaf_node*>(p_node)->keys
+                                       : static_cast<const inner_node*>(p_node)->keys};
+        for (std::size_t i = 0; i < p_node->count; ++i)
+        {
+            if ((0 < i && !m_comparator(p_keys[i - 1], p_keys[i])) ||
+                (nullptr != p_lower && m_comparator(p_keys[i], *p_lower)) ||
+                (nullptr != p_upper && !m_comparator(p_keys[i], *p_upper)))
+            {
+                return false;
+            }
+        }
+
+        if (p_node->leaf)
+        {
+            const auto *p_leaf{static_cast<const leaf_node*>(p_node)};
+            if (0 == leafDepth)
+            {
+                leafDepth = depth;
+            }
+            if (leafDepth != depth || p_leaf->p_prev != p_previous ||
+                (nullptr == p_previous ? m_first : p_previous->p_next) != p_leaf)
+            {
+                return false;
+            }
+            p_previous = p_leaf;
+            count += p_leaf->count;
+            return true;
+        }
+
+        const auto *p_inner{static_cast<const inner_node*>(p_node)};
+        for (std::size_t i = 0; i <= p_inner->count; ++i)
+        {
+            const Key *p_childLower{0 == i ? p_lower : &p_inner->keys[i - 1]};
+            const Key *p_childUpper{p_inner->count == i ? p_upper : &p_inner->keys[i]};
+            if (!validate(p_inner->children[i], p_childLower, p_childUpper, depth + 1, leafDepth, p_previous, count))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    Compare m_comparator{};
+    leaf_allocator m_leafAllocator{};
+    inner_allocator m_innerAllocator{};
+    node_base *m_root{nullptr};
+    leaf_node *m_first{nullptr};
+    leaf_node *m_last{nullptr};
+    size_type m_size{0};
+};
+
+}//ds
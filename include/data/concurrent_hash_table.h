@@ -0,0 +1,156 @@
+#pragma once
+#include <array>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include "hash_table.h"
+#include "tools.h"
+
+namespace ds
+{
+
+/*
+ * Thread safe set splitting the key space across ShardCount independently
+ * locked ds::unordered_set shards. The bucket policies reduce either the raw
+ * hash or ts::mixHash of it, from the low bits (power of two) or the high ones
+ * (fastrange), so the shard is taken from the high bits of a second, salted
+ * mixing round instead: keys of one shard still spread over all its buckets.
+ * Lookups take a shared lock and never block each other; inserts and removals
+ * lock a single shard, which also rehashes on its own.
+ */
+template<typename Key,
+         std::size_t ShardCount = 64,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>,
+         typename Bucket = ds::vector<Key>,
+         typename BucketPolicy = power_of_two_bucket_policy,
+         typename RehashPolicy = eager_rehash_policy>
+class concurrent_unordered_set
+{
+    static_assert(ShardCount > 1 && 0 == (ShardCount & (ShardCount - 1)), "concurrent_unordered_set error: shard count must be a power of two");
+
+    using set_type = unordered_set<Key, Hash, KeyEqual, Bucket, BucketPolicy, RehashPolicy>;
+
+    template<typename K>
+    static constexpr bool lookup_as_is{(ts::is_transparent_v<Hash> && ts::is_transparent_v<KeyEqual>) || std::is_same_v<std::decay_t<K>, Key>};
+
+    // one cache line per shard keeps writers of neighbouring shards from false sharing
+    struct alignas(64) shard
+    {
+        mutable std::shared_mutex mutex;
+        set_type set;
+    };
+
+public:
+    static constexpr std::size_t shard_count{ShardCount};
+
+    explicit concurrent_unordered_set(std::size_t size = 101)
+    {
+        auto shardSize{std::max<std::size_t>(size / ShardCount, 1)};
+        for (auto & s : m_shards)
+        {
+            s.set.reserve(shardSize);
+        }
+    }
+
+    concurrent_unordered_set(const concurrent_unordered_set &) = delete;
+    concurrent_unordered_set & operator=(const concurrent_unordered_set &) = delete;
+
+public:
+    bool contains(const Key & value) const
+    {
+        return containsIn(shardOf(value), value);
+    }
+
+    template<typename K, typename = std::enable_if_t<lookup_as_is<K>>>
+    bool contains(const K & value) const
+    {
+        return containsIn(shardOf(value), value);
+    }
+
+    template<typename K>
+    bool insert(K && value)
+    {
+        auto & s{shardOf(value)};
+        std::unique_lock lock{s.mutex};
+        return s.set.insert(std::forward<K>(value));
+    }
+
+    bool remove(const Key & value)
+    {
+        auto & s{shardOf(value)};
+        std::unique_lock lock{s.mutex};
+        return s.set.remove(value);
+    }
+
+    template<typename K, typename = std::enable_if_t<lookup_as_is<K>>>
+    bool remove(const K & value)
+    {
+        auto & s{shardOf(value)};
+        std::unique_lock lock{s.mutex};
+        return s.set.remove(value);
+    }
+
+    void clear()
+    {
+        for (auto & s : m_shards)
+        {
+            std::unique_lock lock{s.mutex};
+            s.set.clear();
+        }
+    }
+
+    // spreads count keys evenly over the shards
+    void reserve(std::size_t count)
+    {
+        auto shardSize{count / ShardCount + 1};
+        for (auto & s : m_shards)
+        {
+            std::unique_lock lock{s.mutex};
+            s.set.reserve(shardSize);
+        }
+    }
+
+    // shards are visited one after the other: exact only when no writer runs concurrently
+    std::size_t size() const
+    {
+        std::size_t total{0};
+        for (const auto & s : m_shards)
+        {
+            std::shared_lock lock{s.mutex};
+            total += s.set.size();
+        }
+        return total;
+    }
+
+    bool empty() const { return 0 == size(); }
+
+private:
+    template<typename K>
+    bool containsIn(const shard & s, const K & value) const
+    {
+        std::shared_lock lock{s.mutex};
+        return s.set.contains(value);
+    }
+
+    template<typename K>
+    std::size_t shardIndex(const K & value) const
+    {
+        constexpr auto shardBits{static_cast<unsigned>(__builtin_ctzll(ShardCount))};
+        auto hash{ts::mixHash(m_hash(value))};
+        hash = (hash ^ (hash >> 31)) * 0xBF58476D1CE4E5B9ull;
+        return hash >> (64 - shardBits);
+    }
+
+    template<typename K>
+    shard & shardOf(const K & value) { return m_shards[shardIndex(value)]; }
+
+    template<typename K>
+    const shard & shardOf(const K & value) const { return m_shards[shardIndex(value)]; }
+
+private:
+    Hash m_hash{};
+    std::array<shard, ShardCount> m_shards;
+};
+
+}//ds
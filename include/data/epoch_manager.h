@@ -0,0 +1,226 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include "vector.h"
+
+namespace ds
+{
+
+namespace detail
+{
+
+/*
+ * Hands every live thread a small index, reused once the thread exits, so
+ * that any epoch_manager can give each reader thread its own slot without
+ * registering it.
+ */
+class thread_slot_registry
+{
+public:
+    static std::size_t index()
+    {
+        thread_local holder t_holder{acquire()};
+        return t_holder.index;
+    }
+
+private:
+    struct holder
+    {
+        ~holder() { release(index); }
+        std::size_t index;
+    };
+
+    static std::size_t acquire()
+    {
+        std::lock_guard lock{mutex()};
+        auto & free{freeIndices()};
+        if (!free.empty())
+        {
+            auto index{free.back()};
+            free.pop_back();
+            return index;
+        }
+        return nextIndex()++;
+    }
+
+    static void release(std::size_t index)
+    {
+        std::lock_guard lock{mutex()};
+        freeIndices().push_back(index);
+    }
+
+    static std::mutex & mutex() { static std::mutex s_mutex; return s_mutex; }
+    static ds::vector<std::size_t> & freeIndices() { static ds::vector<std::size_t> s_free; return s_free; }
+    static std::size_t & nextIndex() { static std::size_t s_next{0}; return s_next; }
+};
+
+}//detail
+
+/*
+ * Epoch based reclamation for read-mostly structures.
+ * A reader announces the global epoch in its own slot for the duration of a
+ * guard: a load, a store and a fence, no read-modify-write. A writer unlinks
+ * an object, retires it, and the object is freed once every reader still
+ * inside a guard announced an epoch newer than the retirement.
+ */
+class epoch_manager
+{
+    static constexpr std::uint64_t quiescent{0};
+
+    struct alignas(64) reader_slot
+    {
+        std::atomic<std::uint64_t> epoch{quiescent};
+        // touched by the owning thread only
+        std::size_t depth{0};
+    };
+
+    struct retired_object
+    {
+        void *p_object;
+        void (*deleter)(void*);
+        std::uint64_t epoch;
+    };
+
+public:
+    static constexpr std::size_t max_threads{256};
+
+    // keeps the calling thread inside a read side critical section, guards nest
+    class guard
+    {
+    public:
+        explicit guard(epoch_manager & manager) :
+            m_slot{manager.enter()}
+        {}
+
+        ~guard() { epoch_manager::exit(m_slot); }
+
+        guard(const guard &) = delete;
+        guard & operator=(const guard &) = delete;
+
+    private:
+        reader_slot & m_slot;
+    };
+
+    epoch_manager() = default;
+    epoch_manager(const epoch_manager &) = delete;
+    epoch_manager & operator=(const epoch_manager &) = delete;
+
+    // frees whatever is left, no reader may still be running
+    ~epoch_manager()
+    {
+        for (auto & retired : m_retired)
+        {
+            retired.deleter(retired.p_object);
+        }
+    }
+
+    // the manager shared by the containers not given one explicitly
+    static epoch_manager & global()
+    {
+        static epoch_manager s_manager;
+        return s_manager;
+    }
+
+    // hands p_object to deleter once no reader can hold it anymore; p_object must be unlinked already
+    template<typename T, typename Deleter>
+    void retire(T *p_object, Deleter)
+    {
+        static_assert(std::is_empty_v<Deleter>, "epoch_manager error: deleter must be stateless");
+        std::lock_guard lock{m_retiredMutex};
+        m_retired.push_back({const_cast<void*>(static_cast<const void*>(p_object)),
+                             [](void *p){ Deleter{}(static_cast<T*>(p)); },
+                             m_globalEpoch.load(std::memory_order_seq_cst)});
+        reclaim();
+    }
+
+    template<typename T>
+    void retire(T *p_object)
+    {
+        retire(p_object, std::default_delete<T>{});
+    }
+
+    // objects retired and not freed yet
+    std::size_t pending() const
+    {
+        std::lock_guard lock{m_retiredMutex};
+        return m_retired.size();
+    }
+
+    // frees the retired objects no reader can reach, returns how many are left
+    std::size_t collect()
+    {
+        std::lock_guard lock{m_retiredMutex};
+        reclaim();
+        return m_retired.size();
+    }
+
+private:
+    reader_slot & enter()
+    {
+        auto index{detail::thread_slot_registry::index()};
+        if (unlikely(index >= max_threads))
+        {
+            throw std::length_error{"epoch_manager: too many reader threads"};
+        }
+
+        auto & slot{m_slots[index]};
+        if (0 == slot.depth++)
+        {
+            slot.epoch.store(m_globalEpoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+            // orders the announcement before the reads it protects
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        return slot;
+    }
+
+    static void exit(reader_slot & slot)
+    {
+        if (0 == --slot.depth)
+        {
+            slot.epoch.store(quiescent, std::memory_order_release);
+        }
+    }
+
+    // expects m_retiredMutex held
+    void reclaim()
+    {
+        auto current{m_globalEpoch.fetch_add(1, std::memory_order_seq_cst) + 1};
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto oldestActive{current};
+        for (const auto & slot : m_slots)
+        {
+            auto epoch{slot.epoch.load(std::memory_order_acquire)};
+            if (quiescent != epoch && epoch < oldestActive)
+            {
+                oldestActive = epoch;
+            }
+        }
+
+        std::size_t kept{0};
+        for (std::size_t i = 0; i < m_retired.size(); ++i)
+        {
+            if (m_retired[i].epoch < oldestActive)
+            {
+                m_retired[i].deleter(m_retired[i].p_object);
+            }
+            else
+            {
+                m_retired[kept++] = m_retired[i];
+            }
+        }
+        m_retired.resize(kept);
+    }
+
+private:
+    std::atomic<std::uint64_t> m_globalEpoch{1};
+    reader_slot m_slots[max_threads];
+    mutable std::mutex m_retiredMutex;
+    ds::vector<retired_object> m_retired;
+};
+
+}//ds
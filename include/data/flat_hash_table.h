@@ -0,0 +1,496 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "vector.h"
+#include "iterator_facade.h"
+#include "traits.h"
+#include "tools.h"
+#include "base_member_pair.hpp"
+
+namespace ds
+{
+namespace detail
+{
+
+/*
+ * One control byte per slot:
+ * full slots hold the low 7 bits of the key hash (0..127),
+ * the special states all have the sign bit set.
+ */
+using ctrl_t = int8_t;
+constexpr ctrl_t CTRL_EMPTY{-128};
+constexpr ctrl_t CTRL_DELETED{-2};
+constexpr ctrl_t CTRL_SENTINEL{-1};
+
+inline bool isFull(ctrl_t c) { return c >= 0; }
+
+// the control bytes of GROUP_WIDTH consecutive slots, compared all at once
+struct alignas(16) ctrl_group_block
+{
+    ctrl_t bytes[16];
+};
+
+#if defined(__SSE2__)
+class ctrl_group
+{
+public:
+    static constexpr std::size_t GROUP_WIDTH{16};
+
+    explicit ctrl_group(const ctrl_t *ctrl) :
+        m_ctrl{_mm_load_si128(reinterpret_cast<const __m128i*>(ctrl))}
+    {}
+
+    uint32_t match(ctrl_t h2) const
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl)));
+    }
+
+    uint32_t matchEmpty() const { return match(CTRL_EMPTY); }
+
+    // EMPTY and DELETED are the only states smaller than SENTINEL
+    uint32_t matchEmptyOrDeleted() const
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(CTRL_SENTINEL), m_ctrl)));
+    }
+
+private:
+    __m128i m_ctrl;
+};
+#else
+class ctrl_group
+{
+public:
+    static constexpr std::size_t GROUP_WIDTH{16};
+
+    explicit ctrl_group(const ctrl_t *ctrl)
+    {
+        std::memcpy(m_ctrl, ctrl, GROUP_WIDTH);
+    }
+
+    uint32_t match(ctrl_t h2) const
+    {
+        uint32_t mask{0};
+        for (std::size_t i = 0; i < GROUP_WIDTH; ++i)
+        {
+            mask |= static_cast<uint32_t>(m_ctrl[i] == h2) << i;
+        }
+        return mask;
+    }
+
+    uint32_t matchEmpty() const { return match(CTRL_EMPTY); }
+
+    uint32_t matchEmptyOrDeleted() const
+    {
+        uint32_t mask{0};
+        for (std::size_t i = 0; i < GROUP_WIDTH; ++i)
+        {
+            mask |= static_cast<uint32_t>(m_ctrl[i] < CTRL_SENTINEL) << i;
+        }
+        return mask;
+    }
+
+private:
+    ctrl_t m_ctrl[GROUP_WIDTH];
+};
+#endif
+
+inline unsigned lowestBitIndex(uint32_t mask) { return static_cast<unsigned>(__builtin_ctz(mask)); }
+
+}//detail
+
+/*
+ * Open addressing hash set in the style of the Swiss table:
+ * slots are split into aligned groups of 16, each slot has a control byte
+ * holding a 7 bit fragment of its hash, and a lookup compares a whole group
+ * of control bytes against the fragment with a single SSE2 instruction
+ * before touching any key. Groups are visited in triangular order, a probe
+ * stops at the first group which still has an empty slot.
+ */
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>,
+         typename Allocator = std::allocator<Key>>
+class flat_unordered_set
+{
+    static_assert(!ts::is_reference_v<Key>, "flat_unordered_set error: type reference not allowed");
+
+    using ctrl_t = detail::ctrl_t;
+    using group = detail::ctrl_group;
+    using ctrl_block = detail::ctrl_group_block;
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using ctrl_allocator = typename alloc_traits::template rebind_alloc<ctrl_block>;
+    using ctrl_alloc_traits = std::allocator_traits<ctrl_allocator>;
+
+    static constexpr std::size_t GROUP_WIDTH{group::GROUP_WIDTH};
+
+    template<bool>
+    class slot_iterator;
+
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = slot_iterator<true>;
+    using const_iterator = slot_iterator<true>;
+
+private:
+    // keys are immutable in place, both iterators are const
+    template<bool Const>
+    class slot_iterator : public iterator_facade<slot_iterator<Const>, const Key, std::forward_iterator_tag>
+    {
+        friend iterator_facade<slot_iterator<Const>, const Key, std::forward_iterator_tag>;
+        friend flat_unordered_set;
+
+    protected:
+        slot_iterator(const ctrl_t *ctrl, const Key *slot) :
+            p_ctrl{ctrl},
+            p_slot{slot}
+        {
+            skipFreeSlots();
+        }
+
+        template<bool C>
+        bool equals(const slot_iterator<C> & other) const
+        {
+            return p_ctrl == other.p_ctrl;
+        }
+
+        const Key & dereference() const
+        {
+            return *p_slot;
+        }
+
+        void increment()
+        {
+            ++p_ctrl;
+            ++p_slot;
+            skipFreeSlots();
+        }
+
+    private:
+        // the sentinel control byte after the last slot stops the scan
+        void skipFreeSlots()
+        {
+            while (nullptr != p_ctrl && !detail::isFull(*p_ctrl) && detail::CTRL_SENTINEL != *p_ctrl)
+            {
+                ++p_ctrl;
+                ++p_slot;
+            }
+        }
+
+        const ctrl_t *p_ctrl;
+        const Key *p_slot;
+    };
+
+public:
+    explicit flat_unordered_set(size_type size = GROUP_WIDTH, const Allocator & alloc = Allocator()) :
+        m_compressedPair(alloc, 0)
+    {
+        rehash(capacityFor(size));
+    }
+
+    flat_unordered_set(const flat_unordered_set & other) :
+        m_hash{other.m_hash},
+        m_equal{other.m_equal},
+        m_compressedPair(alloc_traits::select_on_container_copy_construction(other.getAlloc()), 0)
+    {
+        rehash(other.m_capacity);
+        for (const auto & key : other)
+        {
+            insertUnique(key, hashOf(key));
+        }
+    }
+
+    flat_unordered_set(flat_unordered_set && other) :
+        m_hash{std::move(other.m_hash)},
+        m_equal{std::move(other.m_equal)},
+        m_compressedPair(other.getAlloc(), std::exchange(other.getSize(), 0))
+    {
+        m_ctrl = std::exchange(other.m_ctrl, nullptr);
+        m_slots = std::exchange(other.m_slots, nullptr);
+        m_capacity = std::exchange(other.m_capacity, 0);
+        m_deleted = std::exchange(other.m_deleted, 0);
+    }
+
+    flat_unordered_set & operator=(flat_unordered_set other)
+    {
+        swap(other);
+        return *this;
+    }
+
+    void swap(flat_unordered_set & other)
+    {
+        using std::swap;
+        swap(m_hash, other.m_hash);
+        swap(m_equal, other.m_equal);
+        swap(getAlloc(), other.getAlloc());
+        swap(getSize(), other.getSize());
+        swap(m_ctrl, other.m_ctrl);
+        swap(m_slots, other.m_slots);
+        swap(m_capacity, other.m_capacity);
+        swap(m_deleted, other.m_deleted);
+    }
+
+    ~flat_unordered_set()
+    {
+        destroySlots();
+        releaseStorage(m_ctrl, m_slots, m_capacity);
+    }
+
+public:
+    iterator begin() const { return iterator(m_ctrl, m_slots); }
+    iterator end() const { return iterator(m_ctrl + m_capacity, m_slots + m_capacity); }
+
+    bool contains(const Key & value) const
+    {
+        return nullptr != find(value, hashOf(value));
+    }
+
+    template<typename K>
+    bool insert(K && value)
+    {
+        auto hash{hashOf(value)};
+        if (nullptr != find(value, hash))
+        {
+            return false;
+        }
+
+        if (unlikely(getSize() + m_deleted + 1 > maxLoad(m_capacity)))
+        {
+            // a table clogged with tombstones is cleaned in place, a full one doubles
+            rehash(getSize() + 1 > maxLoad(m_capacity) / 2 ? capacityFor(maxLoad(m_capacity) + 1) : m_capacity);
+        }
+
+        insertUnique(std::forward<K>(value), hash);
+        return true;
+    }
+
+    bool remove(const Key & value)
+    {
+        Key *p_slot = find(value, hashOf(value));
+        if (nullptr == p_slot)
+        {
+            return false;
+        }
+
+        auto index{static_cast<size_type>(p_slot - m_slots)};
+        alloc_traits::destroy(getAlloc(), p_slot);
+
+        // a group which still has an empty slot was never full, so no probe went past it
+        // and the slot can become empty again; otherwise it has to stay a tombstone
+        const ctrl_t *p_group = m_ctrl + (index & ~(GROUP_WIDTH - 1));
+        if (0 != group(p_group).matchEmpty())
+        {
+            m_ctrl[index] = detail::CTRL_EMPTY;
+        }
+        else
+        {
+            m_ctrl[index] = detail::CTRL_DELETED;
+            ++m_deleted;
+        }
+        --getSize();
+        return true;
+    }
+
+    void clear()
+    {
+        // a moved-from set owns no control bytes
+        if (0 == m_capacity)
+        {
+            return;
+        }
+
+        destroySlots();
+        std::memset(m_ctrl, static_cast<uint8_t>(detail::CTRL_EMPTY), m_capacity);
+        getSize() = 0;
+        m_deleted = 0;
+    }
+
+    void reserve(size_type count)
+    {
+        if (count > maxLoad(m_capacity))
+        {
+            rehash(capacityFor(count));
+        }
+    }
+
+    bool empty() const { return 0 == getSize(); }
+    size_type size() const { return getSize(); }
+    size_type capacity() const { return m_capacity; }
+
+private:
+    // spreads identity hashes of integers over the whole word before splitting it:
+    // the high bits pick the group, the low 7 bits are stored in the control byte
+    std::size_t hashOf(const Key & value) const
+    {
+        return ts::mixHash(m_hash(value));
+    }
+
+    static size_type h1(std::size_t hash) { return hash >> 7; }
+    static ctrl_t h2(std::size_t hash) { return static_cast<ctrl_t>(hash & 0x7F); }
+
+    static size_type maxLoad(size_type capacity) { return capacity - capacity / 8; }
+
+    static size_type capacityFor(size_type count)
+    {
+        size_type capacity{GROUP_WIDTH};
+        while (maxLoad(capacity) < count)
+        {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    size_type groupMask() const { return m_capacity / GROUP_WIDTH - 1; }
+
+    Key *find(const Key & value, std::size_t hash) const
+    {
+        if (unlikely(0 == m_capacity))
+        {
+            return nullptr;
+        }
+
+        auto fragment{h2(hash)};
+        auto groupIdx{h1(hash) & groupMask()};
+        for (size_type step = 1; ; ++step)
+        {
+            const ctrl_t *p_group = m_ctrl + groupIdx * GROUP_WIDTH;
+            group g{p_group};
+            for (auto mask = g.match(fragment); 0 != mask; mask &= mask - 1)
+            {
+                Key *p_slot = m_slots + groupIdx * GROUP_WIDTH + detail::lowestBitIndex(mask);
+                if (likely(m_equal(*p_slot, value)))
+                {
+                    return p_slot;
+                }
+            }
+
+            if (likely(0 != g.matchEmpty()) || step > groupMask())
+            {
+                return nullptr;
+            }
+            groupIdx = (groupIdx + step) & groupMask();
+        }
+    }
+
+    // expects the key to be absent and a free slot to be available
+    template<typename K>
+    void insertUnique(K && value, std::size_t hash)
+    {
+        auto index{findFreeSlot(m_ctrl, m_capacity, hash)};
+        if (detail::CTRL_DELETED == m_ctrl[index])
+        {
+            --m_deleted;
+        }
+
+        m_ctrl[index] = h2(hash);
+        alloc_traits::construct(getAlloc(), m_slots + index, std::forward<K>(value));
+        ++getSize();
+    }
+
+    static size_type findFreeSlot(const ctrl_t *ctrl, size_type capacity, std::size_t hash)
+    {
+        auto mask{capacity / GROUP_WIDTH - 1};
+        auto groupIdx{h1(hash) & mask};
+        for (size_type step = 1; ; ++step)
+        {
+            if (auto free = group(ctrl + groupIdx * GROUP_WIDTH).matchEmptyOrDeleted(); 0 != free)
+            {
+                return groupIdx * GROUP_WIDTH + detail::lowestBitIndex(free);
+            }
+            groupIdx = (groupIdx + step) & mask;
+        }
+    }
+
+    // moves every key straight into its slot of a freshly allocated table
+    void rehash(size_type newCapacity)
+    {
+        auto & alloc = getAlloc();
+        ctrl_t *p_newCtrl = allocateCtrl(newCapacity);
+        Key *p_newSlots = alloc_traits::allocate(alloc, newCapacity);
+
+        for (size_type i = 0; i < m_capacity; ++i)
+        {
+            if (detail::isFull(m_ctrl[i]))
+            {
+                auto hash{hashOf(m_slots[i])};
+                auto index{findFreeSlot(p_newCtrl, newCapacity, hash)};
+                p_newCtrl[index] = h2(hash);
+                detail::relocate(alloc, m_slots + i, p_newSlots + index, 1);
+            }
+        }
+
+        releaseStorage(m_ctrl, m_slots, m_capacity);
+        m_ctrl = p_newCtrl;
+        m_slots = p_newSlots;
+        m_capacity = newCapacity;
+        m_deleted = 0;
+    }
+
+    ctrl_t *allocateCtrl(size_type capacity)
+    {
+        ctrl_allocator alloc{getAlloc()};
+        // one extra block carries the sentinel which terminates iteration
+        auto *p_blocks = ctrl_alloc_traits::allocate(alloc, capacity / GROUP_WIDTH + 1);
+        ctrl_t *p_ctrl = p_blocks->bytes;
+        std::memset(p_ctrl, static_cast<uint8_t>(detail::CTRL_EMPTY), capacity + GROUP_WIDTH);
+        p_ctrl[capacity] = detail::CTRL_SENTINEL;
+        return p_ctrl;
+    }
+
+    void releaseStorage(ctrl_t *p_ctrl, Key *p_slots, size_type capacity)
+    {
+        if (nullptr == p_ctrl)
+        {
+            return;
+        }
+
+        ctrl_allocator alloc{getAlloc()};
+        ctrl_alloc_traits::deallocate(alloc, reinterpret_cast<ctrl_block*>(p_ctrl), capacity / GROUP_WIDTH + 1);
+        alloc_traits::deallocate(getAlloc(), p_slots, capacity);
+    }
+
+    void destroySlots()
+    {
+        if constexpr (!std::is_trivially_destructible_v<Key>)
+        {
+            for (size_type i = 0; i < m_capacity; ++i)
+            {
+                if (detail::isFull(m_ctrl[i]))
+                {
+                    alloc_traits::destroy(getAlloc(), m_slots + i);
+                }
+            }
+        }
+    }
+
+    size_type & getSize() { return m_compressedPair.member(); }
+    const size_type & getSize() const { return m_compressedPair.member(); }
+    Allocator & getAlloc() { return m_compressedPair.base(); }
+    const Allocator & getAlloc() const { return m_compressedPair.base(); }
+
+private:
+    ctrl_t *m_ctrl{nullptr};
+    Key *m_slots{nullptr};
+    size_type m_capacity{0};
+    size_type m_deleted{0};
+    Hash m_hash{};
+    KeyEqual m_equal{};
+    ts::BaseMemberPair<Allocator, size_type> m_compressedPair{};
+};
+
+}//ds
@@ -1,79 +1,393 @@
 #pragma once
+#include <algorithm>
 #include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <string>
+#include <string_view>
 #include <type_traits>
 //#include <vector>
 #include "vector.h"
+#include "small_vector.h"
+#include "bloom_filter.h"
 #include "tools.h"
 
 
 namespace ds
 {
 
+/*
+ * Bucket policies decide how many buckets the table has and how a hash is
+ * reduced to a bucket index.
+ */
+
+// prime bucket counts with a modulo reduction: tolerant of weak hashes,
+// but every lookup pays an integer division and every rehash a prime search
+struct prime_bucket_policy
+{
+    static std::size_t bucketCount(std::size_t requested)
+    {
+        return ts::isPrime(requested) ? requested : ts::nextPrime(requested);
+    }
+
+    static std::size_t nextBucketCount(std::size_t current)
+    {
+        return ts::nextPrime(current * 2);
+    }
+
+    static std::size_t index(std::size_t hash, std::size_t bucketCount)
+    {
+        return hash % bucketCount;
+    }
+};
+
+// power of two bucket counts: the reduction is a mask over the mixed hash
+struct power_of_two_bucket_policy
+{
+    static std::size_t bucketCount(std::size_t requested)
+    {
+        return ts::nextLargerPowerOf2(requested);
+    }
+
+    static std::size_t nextBucketCount(std::size_t current)
+    {
+        return current * 2;
+    }
+
+    static std::size_t index(std::size_t hash, std::size_t bucketCount)
+    {
+        return ts::mixHash(hash) & (bucketCount - 1);
+    }
+};
+
+/*
+ * Lemire's fastrange: maps the mixed hash onto [0, bucketCount) with a
+ * 64x64->128 bit multiply and a shift, for any bucket count
+ * https://lemire.me/blog/2016/06/27/a-fast-alternative-to-the-modulo-reduction/
+ */
+struct fastrange_bucket_policy
+{
+    static std::size_t bucketCount(std::size_t requested)
+    {
+        return std::max<std::size_t>(requested, 1);
+    }
+
+    static std::size_t nextBucketCount(std::size_t current)
+    {
+        return std::max<std::size_t>(current * 2, 2);
+    }
+
+    static std::size_t index(std::size_t hash, std::size_t bucketCount)
+    {
+        return static_cast<std::size_t>((static_cast<unsigned __int128>(ts::mixHash(hash)) * bucketCount) >> 64);
+    }
+};
+
+/*
+ * Rehash policies decide how the table moves its keys once it outgrows its buckets.
+ */
+
+// moves every key at once, inside the insert that crossed the load factor
+struct eager_rehash_policy
+{
+    static constexpr std::size_t step_buckets{0};
+};
+
+/*
+ * Keeps the old bucket array next to the new one and migrates StepBuckets
+ * old buckets on every insert and remove, Redis dict style. Lookups check
+ * both arrays until the migration is over, trading a little steady state
+ * speed for the absence of a whole table stall.
+ */
+template<std::size_t StepBuckets = 8>
+struct incremental_rehash_policy
+{
+    static_assert(StepBuckets > 0, "incremental_rehash_policy error: a step must migrate at least one bucket");
+    static constexpr std::size_t step_buckets{StepBuckets};
+};
+
+/*
+ * Filter policies keep an approximate membership filter in front of the
+ * buckets: a key the filter rejects is missing without any bucket access.
+ */
+
+// no filter: every lookup goes to its bucket
+struct no_filter
+{};
+
+// transparent hasher for std::string keys: string_view and const char* lookups hash in place
+struct string_hash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view key) const noexcept
+    {
+        return std::hash<std::string_view>{}(key);
+    }
+};
+
+// a slot value stored next to its full hash, for keys that are expensive to hash or compare
+template<typename T>
+struct hashed_value
+{
+    std::size_t hash;
+    T value;
+};
+
+namespace detail
+{
+
+// extracts the key from a slot value: the value itself for sets
+struct identity_key
+{
+    template<typename V>
+    static const V & get(const V & value) { return value; }
+};
+
+// extracts the key from a slot value: the first member of the pair for maps
+struct pair_first_key
+{
+    template<typename V>
+    static const auto & get(const V & value) { return value.first; }
+};
+
+/*
+ * Separate chaining table shared by ds::unordered_set and ds::unordered_map.
+ * Value is what a slot holds and KeyOf extracts its Key.
+ * Bucket is any sequence of slots offering push_back, erase and iteration:
+ * ds::vector<Value> by default, or ds::small_vector<Value, N> to keep the
+ * first N slots of each bucket inline and skip the allocation on first insert.
+ * A bucket of hashed_value<Value> caches every hash: rehashing never calls
+ * Hash and a bucket scan only calls KeyEqual on keys whose hash matches.
+ * When both Hash and KeyEqual are transparent (ds::string_hash and
+ * std::equal_to<>), lookups accept any key type they understand.
+ * A Filter other than no_filter (ds::bloom_filter) is sized for the bucket
+ * count and fed every inserted hash; removed keys only leave it when the
+ * next rehash rebuilds it from the remaining ones.
+ */
 template<typename Key,
-         typename Hash = std::hash<Key>,
-         typename KeyEqual = std::equal_to<Key>>
-class unordered_set
+         typename Value,
+         typename KeyOf,
+         typename Hash,
+         typename KeyEqual,
+         typename Bucket,
+         typename BucketPolicy,
+         typename RehashPolicy,
+         typename Filter = no_filter>
+class hash_table
 {
-    static_assert(!ts::is_reference_v<Key>, "unordered_set error: type reference not allowed");
+    using Entry = typename Bucket::value_type;
+
+    static constexpr bool cached_hash{std::is_same_v<Entry, hashed_value<Value>>};
+    static constexpr bool incremental_rehash{0 != RehashPolicy::step_buckets};
+    static constexpr bool transparent_lookup{ts::is_transparent_v<Hash> && ts::is_transparent_v<KeyEqual>};
+    static constexpr bool has_filter{!std::is_same_v<Filter, no_filter>};
+
+    static_assert(!ts::is_reference_v<Key>, "hash_table error: type reference not allowed");
+    static_assert(!(has_filter && incremental_rehash), "hash_table error: a filter is rebuilt by each rehash and needs the eager rehash policy");
+    static_assert(std::is_same_v<Entry, Value> || cached_hash, "hash_table error: bucket must hold slot values or hashed slot values");
     template<typename... Args>
     using Container = ds::vector<Args...>;
-    using Bucket = Container<Key>;
-    using BucketIterator = typename Bucket::iterator;
-    using BucketConstIterator = typename Bucket::const_iterator;
     using BucketContainer = Container<Bucket>;
 
+    // pipeline stages of a batched lookup are this many keys apart
+    static constexpr std::size_t batch_distance{16};
+
 public:
-    explicit unordered_set(std::size_t size = 101)
+    // K is looked up as is rather than converted to Key first
+    template<typename K>
+    static constexpr bool lookup_as_is{transparent_lookup || std::is_same_v<std::decay_t<K>, Key>};
+
+    explicit hash_table(std::size_t size)
     {
-        m_buckets.resize(101);
+        allocateBuckets(m_buckets, BucketPolicy::bucketCount(size));
     }
 
-public:
-    bool contains(const Key & value) const
+    template<typename K>
+    const Value * find(const K & key) const
     {
-        auto index{generateHash(value)};
-        auto & bucket{m_buckets[index]};
-        auto [res, it] = contains(bucket, value, m_equal);
-        return res;
+        auto hash{m_hash(key)};
+        if constexpr (has_filter)
+        {
+            // a rejected key never touches the bucket array
+            if (!m_filter.contains_hash(hash))
+            {
+                return nullptr;
+            }
+        }
+
+        auto & bucket{m_buckets[bucketIndex(hash)]};
+        auto it{findEntry(bucket, hash, key, m_equal)};
+        if (std::end(bucket) != it)
+        {
+            return std::addressof(valueOf(*it));
+        }
+
+        if constexpr (incremental_rehash)
+        {
+            if (auto * oldBucket{findOldBucket(hash)}; oldBucket)
+            {
+                if (auto oldIt{findEntry(*oldBucket, hash, key, m_equal)}; std::end(*oldBucket) != oldIt)
+                {
+                    return std::addressof(valueOf(*oldIt));
+                }
+            }
+        }
+        return nullptr;
     }
 
     template<typename K>
-    bool insert(K && value)
+    Value * find(const K & key)
+    {
+        return const_cast<Value*>(std::as_const(*this).find(key));
+    }
+
+    /*
+     * Looks up count keys as a software pipeline whose stages are batch_distance
+     * keys apart: key i is hashed and its bucket header prefetched, the bucket
+     * data of an earlier key is prefetched, and a still earlier one is compared.
+     * With a filter, a first stage prefetches the filter block and a second one
+     * tests it, so rejected keys never touch their bucket.
+     */
+    template<typename K>
+    void findBatch(const K *keys, std::size_t count, bool *results) const
     {
-        auto index{generateHash(value)};
-//        std::cout << "unordered_set::insert() value: " << value << " generated index: " << index << "\n";
-        auto & bucket{m_buckets[index]};
+        constexpr std::size_t ringMask{4 * batch_distance - 1};
+        constexpr std::size_t filterStage{has_filter ? 1 : 0};
+        constexpr std::size_t dataStage{filterStage + 1};
+        constexpr std::size_t compareStage{filterStage + 2};
+        std::size_t hashes[ringMask + 1];
+        bool candidates[ringMask + 1];
+        auto keyAt = [count](std::size_t i, std::size_t stage, std::size_t & k){
+            k = i - stage * batch_distance;
+            return i >= stage * batch_distance && k < count;
+        };
 
-        if (auto [res, it] = contains(bucket, value, m_equal); !res)
+        std::size_t k{0};
+        for (std::size_t i = 0; i < count + compareStage * batch_distance; ++i)
         {
-            bucket.push_back(std::forward<K>(value));
-            bucket.push_back(std::forward<K>(value));
-            ++m_currentSize;
+            if (i < count)
+            {
+                auto hash{m_hash(keys[i])};
+                hashes[i & ringMask] = hash;
+                candidates[i & ringMask] = true;
+                if constexpr (has_filter)
+                {
+                    m_filter.prefetch_hash(hash);
+                }
+                else
+                {
+                    __builtin_prefetch(&m_buckets[bucketIndex(hash)]);
+                }
+            }
 
-            if (m_currentSize >= m_buckets.size())
+            if constexpr (has_filter)
             {
-                rehash();
+                if (keyAt(i, filterStage, k))
+                {
+                    auto hash{hashes[k & ringMask]};
+                    candidates[k & ringMask] = m_filter.contains_hash(hash);
+                    if (candidates[k & ringMask])
+                    {
+                        __builtin_prefetch(&m_buckets[bucketIndex(hash)]);
+                    }
+                }
             }
 
-            return true;
-        }
+            if (keyAt(i, dataStage, k) && candidates[k & ringMask])
+            {
+                const auto & bucket{m_buckets[bucketIndex(hashes[k & ringMask])]};
+                if (!bucket.empty())
+                {
+                    __builtin_prefetch(std::addressof(*std::begin(bucket)));
+                }
+            }
 
-        return false;
+            if (keyAt(i, compareStage, k))
+            {
+                auto hash{hashes[k & ringMask]};
+                const auto & bucket{m_buckets[bucketIndex(hash)]};
+                results[k] = candidates[k & ringMask] && std::end(bucket) != findEntry(bucket, hash, keys[k], m_equal);
+                if constexpr (incremental_rehash)
+                {
+                    if (auto * oldBucket{findOldBucket(hash)}; !results[k] && oldBucket)
+                    {
+                        results[k] = std::end(*oldBucket) != findEntry(*oldBucket, hash, keys[k], m_equal);
+                    }
+                }
+            }
+        }
     }
 
-    bool remove(const Key & value)
+    /*
+     * Builds a Value from args only when key is missing. The returned pointer
+     * stays valid until the next insertion or removal.
+     */
+    template<typename K, typename... Args>
+    std::pair<Value*, bool> emplace(const K & key, Args&&... args)
     {
-        auto index{generateHash(value)};
-        auto & bucket{m_buckets[index]};
+        auto hash{m_hash(key)};
+        if constexpr (incremental_rehash)
+        {
+            if (isMigrating())
+            {
+                migrateStep();
+            }
+        }
 
-        if (auto [res, it] = contains(bucket, value, m_equal); res)
+        if (auto * p_value{findHashed(hash, key)}; p_value)
         {
-            bucket.erase(it);
-            --m_currentSize;
-            return true;
+            return {p_value, false};
         }
 
-        return false;
+        // growing first keeps the new slot where it is constructed
+        if (m_currentSize + 1 >= m_buckets.size())
+        {
+            if constexpr (incremental_rehash)
+            {
+                startMigration(BucketPolicy::nextBucketCount(m_buckets.size()));
+            }
+            else
+            {
+                rehash();
+            }
+        }
+
+        auto & bucket{m_buckets[bucketIndex(hash)]};
+        if constexpr (cached_hash)
+        {
+            bucket.push_back(Entry{hash, Value(std::forward<Args>(args)...)});
+        }
+        else
+        {
+            bucket.push_back(Value(std::forward<Args>(args)...));
+        }
+        if constexpr (has_filter)
+        {
+            m_filter.insert_hash(hash);
+        }
+        ++m_currentSize;
+        return {std::addressof(valueOf(bucket.back())), true};
+    }
+
+    template<typename K>
+    bool erase(const K & key)
+    {
+        auto hash{m_hash(key)};
+        if constexpr (incremental_rehash)
+        {
+            if (isMigrating())
+            {
+                migrateStep();
+                if (auto * oldBucket{findOldBucket(hash)}; oldBucket && erase(*oldBucket, hash, key))
+                {
+                    return true;
+                }
+            }
+        }
+
+        return erase(m_buckets[bucketIndex(hash)], hash, key);
     }
 
     void clear()
@@ -82,69 +396,281 @@ public:
         {
             bucket.clear();
         }
+        m_oldBuckets = BucketContainer{};
+        m_migrationIndex = 0;
         m_currentSize = 0;
+        resetFilter();
     }
 
-    
+    // makes room for count keys, so that inserting them rehashes at most once here
+    void reserve(std::size_t count)
+    {
+        auto bucketCount{BucketPolicy::bucketCount(count + 1)};
+        if (bucketCount > m_buckets.size())
+        {
+            finishMigration();
+            rehash(bucketCount);
+        }
+    }
+
+    // true while an incremental rehash still has old buckets to move
+    bool rehashing() const { return isMigrating(); }
+
+    std::size_t size() const { return m_currentSize; }
+    bool empty() const { return 0 == m_currentSize; }
+    std::size_t bucket_count() const { return m_buckets.size(); }
+
 private:
-    static __attribute__((always_inline)) std::pair<bool, BucketConstIterator> 
-    contains(const Bucket & bucket, const Key & value, const KeyEqual & equal)
+    static const Value & valueOf(const Entry & entry)
     {
-        auto it = std::find_if(std::begin(bucket), std::end(bucket), [&equal, &v = std::as_const(value)] (const auto & item){ 
-                               return equal(v, item); });
+        if constexpr (cached_hash)
+        {
+            return entry.value;
+        }
+        else
+        {
+            return entry;
+        }
+    }
 
-        return std::make_pair(std::end(bucket) != it, it);
+    static Value & valueOf(Entry & entry)
+    {
+        return const_cast<Value&>(valueOf(std::as_const(entry)));
     }
 
-    std::size_t generateHash(const Key & value) const
+    // B is Bucket or const Bucket, the iterator returned follows its constness
+    template<typename B, typename K>
+    static __attribute__((always_inline)) auto
+    findEntry(B & bucket, std::size_t hash, const K & key, const KeyEqual & equal)
     {
-//        std::cout << "unordered_set::generateHash() value: " << value 
-//                  << " hash(value): " << m_hash(value) 
-//                  << " index: " << m_hash(value) % m_buckets.size() << "\n";
-        return m_hash(value) % m_buckets.size();
+        return std::find_if(std::begin(bucket), std::end(bucket), [&equal, hash, &k = std::as_const(key)] (const auto & item){
+                            if constexpr (cached_hash)
+                            {
+                                return item.hash == hash && equal(k, KeyOf::get(item.value));
+                            }
+                            else
+                            {
+                                return equal(k, KeyOf::get(item));
+                            }});
     }
 
-    void rehash()
+    template<typename K>
+    Value * findHashed(std::size_t hash, const K & key)
     {
-        auto newSize = ts::nextPrime(m_buckets.size()*2);
-        std::cout << "unordered_set::rehash() new size: " << newSize << "\n";
-        BucketContainer oldTable{};
-        transferElements(m_buckets, oldTable);
-        clear();
-        m_buckets.resize(newSize);
-        for (auto & bucket : oldTable)
+        if constexpr (has_filter)
         {
-            for (auto & el : bucket)
+            if (!m_filter.contains_hash(hash))
             {
-                if constexpr(std::is_move_constructible_v<Key>)
-                {
-                    insert(std::move(el));
-                }
-                else
+                return nullptr;
+            }
+        }
+
+        auto & bucket{m_buckets[bucketIndex(hash)]};
+        if (auto it{findEntry(bucket, hash, key, m_equal)}; std::end(bucket) != it)
+        {
+            return std::addressof(valueOf(*it));
+        }
+
+        if constexpr (incremental_rehash)
+        {
+            if (auto * oldBucket{findOldBucket(hash)}; oldBucket)
+            {
+                if (auto it{findEntry(*oldBucket, hash, key, m_equal)}; std::end(*oldBucket) != it)
                 {
-                    insert(el);
+                    return std::addressof(valueOf(*it));
                 }
             }
         }
+        return nullptr;
     }
 
-    void transferElements(BucketContainer & in, BucketContainer & out)
+    template<typename K>
+    bool erase(Bucket & bucket, std::size_t hash, const K & key)
     {
-        out.reserve(in.size());
-        for (auto & srcBucket : in)
+        if (auto it{findEntry(bucket, hash, key, m_equal)}; std::end(bucket) != it)
         {
-            out.push_back({});
-            auto & destBucket{out.back()}; 
-            destBucket.reserve(srcBucket.size());
-            if constexpr(std::is_move_constructible_v<Key>)
+            bucket.erase(it);
+            --m_currentSize;
+            return true;
+        }
+
+        return false;
+    }
+
+    std::size_t bucketIndex(std::size_t hash) const
+    {
+        return BucketPolicy::index(hash, m_buckets.size());
+    }
+
+    // the stored hash when the bucket caches it, a fresh one otherwise
+    std::size_t hashOf(const Entry & entry) const
+    {
+        if constexpr (cached_hash)
+        {
+            return entry.hash;
+        }
+        else
+        {
+            return m_hash(KeyOf::get(entry));
+        }
+    }
+
+    static Filter makeFilter(std::size_t bucketCount)
+    {
+        if constexpr (has_filter)
+        {
+            return Filter(bucketCount);
+        }
+        else
+        {
+            return Filter{};
+        }
+    }
+
+    void resetFilter()
+    {
+        if constexpr (has_filter)
+        {
+            m_filter = makeFilter(m_buckets.size());
+        }
+    }
+
+    // reserving first keeps resize from doubling the capacity of a large bucket array
+    static void allocateBuckets(BucketContainer & buckets, std::size_t bucketCount)
+    {
+        buckets.reserve(bucketCount);
+        buckets.resize(bucketCount);
+    }
+
+    static void moveEntry(Entry & entry, Bucket & destBucket)
+    {
+        if constexpr(std::is_move_constructible_v<Entry>)
+        {
+            destBucket.push_back(std::move(entry));
+        }
+        else
+        {
+            destBucket.push_back(entry);
+        }
+    }
+
+    bool isMigrating() const
+    {
+        return !m_oldBuckets.empty();
+    }
+
+    // the old bucket of a hash, or nullptr once that bucket has been migrated
+    const Bucket * findOldBucket(std::size_t hash) const
+    {
+        if (!isMigrating())
+        {
+            return nullptr;
+        }
+        auto index{BucketPolicy::index(hash, m_oldBuckets.size())};
+        return index < m_migrationIndex ? nullptr : &m_oldBuckets[index];
+    }
+
+    Bucket * findOldBucket(std::size_t hash)
+    {
+        return const_cast<Bucket*>(std::as_const(*this).findOldBucket(hash));
+    }
+
+    void startMigration(std::size_t bucketCount)
+    {
+        finishMigration();
+        m_oldBuckets = std::move(m_buckets);
+        m_buckets = BucketContainer{};
+        allocateBuckets(m_buckets, bucketCount);
+        m_migrationIndex = 0;
+    }
+
+    // the new array is twice the old one, so the migration ends before the next one is due
+    void migrateStep()
+    {
+        auto last{std::min(m_migrationIndex + RehashPolicy::step_buckets, m_oldBuckets.size())};
+        for (; m_migrationIndex < last; ++m_migrationIndex)
+        {
+            migrateBucket(m_oldBuckets[m_migrationIndex]);
+        }
+
+        if (m_migrationIndex == m_oldBuckets.size())
+        {
+            m_oldBuckets = BucketContainer{};
+            m_migrationIndex = 0;
+        }
+    }
+
+    void finishMigration()
+    {
+        while (isMigrating())
+        {
+            migrateStep();
+        }
+    }
+
+    void migrateBucket(Bucket & oldBucket)
+    {
+        for (auto & entry : oldBucket)
+        {
+            moveEntry(entry, m_buckets[bucketIndex(hashOf(entry))]);
+        }
+        // releases the bucket storage as well
+        oldBucket = Bucket{};
+    }
+
+    void rehash()
+    {
+        rehash(BucketPolicy::nextBucketCount(m_buckets.size()));
+    }
+
+    /*
+     * Moves every key straight into its bucket of a table with bucketCount buckets.
+     * The keys are already unique, so no duplicate scan is done; a first pass
+     * records each key's new index and sizes the buckets, a second pass moves the keys.
+     */
+    void rehash(std::size_t bucketCount)
+    {
+        Container<std::size_t> indices;
+        indices.reserve(m_currentSize);
+        Container<std::size_t> counts;
+        counts.resize(bucketCount);
+        auto newFilter{makeFilter(bucketCount)};
+        for (const auto & bucket : m_buckets)
+        {
+            for (const auto & entry : bucket)
             {
-                std::move(std::begin(srcBucket), std::end(srcBucket), std::back_inserter(destBucket));
+                auto hash{hashOf(entry)};
+                auto index{BucketPolicy::index(hash, bucketCount)};
+                indices.push_back(index);
+                ++counts[index];
+                if constexpr (has_filter)
+                {
+                    newFilter.insert_hash(hash);
+                }
             }
-            else
+        }
+
+        BucketContainer newBuckets;
+        allocateBuckets(newBuckets, bucketCount);
+        for (std::size_t i = 0; i < bucketCount; ++i)
+        {
+            if (0 != counts[i])
             {
-                std::copy(std::begin(srcBucket), std::end(srcBucket), std::back_inserter(destBucket));
+                newBuckets[i].reserve(counts[i]);
             }
         }
+
+        auto indexIt{std::begin(indices)};
+        for (auto & bucket : m_buckets)
+        {
+            for (auto & entry : bucket)
+            {
+                moveEntry(entry, newBuckets[*indexIt++]);
+            }
+        }
+
+        m_buckets = std::move(newBuckets);
+        m_filter = std::move(newFilter);
     }
 
 private:
@@ -152,6 +678,278 @@ private:
     Hash m_hash{};
     KeyEqual m_equal{};
     BucketContainer m_buckets;
+    BucketContainer m_oldBuckets;
+    std::size_t m_migrationIndex{0};
+    Filter m_filter{};
 };
 
+}//detail
+
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>,
+         typename Bucket = ds::vector<Key>,
+         typename BucketPolicy = power_of_two_bucket_policy,
+         typename RehashPolicy = eager_rehash_policy,
+         typename Filter = no_filter>
+class unordered_set
+{
+    using table_type = detail::hash_table<Key, Key, detail::identity_key, Hash, KeyEqual, Bucket, BucketPolicy, RehashPolicy, Filter>;
+
+    template<typename K>
+    static constexpr bool lookup_as_is{table_type::template lookup_as_is<K>};
+
+public:
+    explicit unordered_set(std::size_t size = 101) :
+        m_table(size)
+    {}
+
+public:
+    bool contains(const Key & value) const
+    {
+        return nullptr != m_table.find(value);
+    }
+
+    template<typename K, typename = std::enable_if_t<lookup_as_is<K>>>
+    bool contains(const K & value) const
+    {
+        return nullptr != m_table.find(value);
+    }
+
+    // results[i] tells whether keys[i] is in the set; faster than single lookups once the table outgrows the cache
+    void contains_batch(const Key *keys, std::size_t count, bool *results) const
+    {
+        m_table.findBatch(keys, count, results);
+    }
+
+    template<typename K, typename = std::enable_if_t<lookup_as_is<K>>>
+    void contains_batch(const K *keys, std::size_t count, bool *results) const
+    {
+        m_table.findBatch(keys, count, results);
+    }
+
+    template<typename K>
+    bool insert(K && value)
+    {
+        if constexpr (lookup_as_is<K>)
+        {
+            return m_table.emplace(value, std::forward<K>(value)).second;
+        }
+        else
+        {
+            Key key(std::forward<K>(value));
+            return m_table.emplace(key, std::move(key)).second;
+        }
+    }
+
+    bool remove(const Key & value)
+    {
+        return m_table.erase(value);
+    }
+
+    template<typename K, typename = std::enable_if_t<lookup_as_is<K>>>
+    bool remove(const K & value)
+    {
+        return m_table.erase(value);
+    }
+
+    void clear() { m_table.clear(); }
+
+    // makes room for count keys, so that inserting them rehashes at most once here
+    void reserve(std::size_t count) { m_table.reserve(count); }
+
+    // true while an incremental rehash still has old buckets to move
+    bool rehashing() const { return m_table.rehashing(); }
+
+    std::size_t size() const { return m_table.size(); }
+    bool empty() const { return m_table.empty(); }
+    std::size_t bucket_count() const { return m_table.bucket_count(); }
+
+private:
+    table_type m_table;
+};
+
+/*
+ * Key to value map over the same table: each slot keeps the key and its
+ * value together in a std::pair. Lookups hand out pointers to the mapped
+ * value, valid until the next insertion or removal.
+ */
+template<typename Key,
+         typename T,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>,
+         typename Bucket = ds::vector<std::pair<Key, T>>,
+         typename BucketPolicy = power_of_two_bucket_policy,
+         typename RehashPolicy = eager_rehash_policy>
+class unordered_map
+{
+    using slot_type = std::pair<Key, T>;
+    using table_type = detail::hash_table<Key, slot_type, detail::pair_first_key, Hash, KeyEqual, Bucket, BucketPolicy, RehashPolicy>;
+
+    template<typename K>
+    static constexpr bool lookup_as_is{table_type::template lookup_as_is<K>};
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+
+    explicit unordered_map(std::size_t size = 101) :
+        m_table(size)
+    {}
+
+public:
+    bool contains(const Key & key) const
+    {
+        return nullptr != m_table.find(key);
+    }
+
+    template<typename K, typename = std::enable_if_t<lookup_as_is<K>>>
+    bool contains(const K & key) const
+    {
+        return nullptr != m_table.find(key);
+    }
+
+    // the mapped value of key, or nullptr when key is missing
+    T * find(const Key & key) { return mappedOf(m_table.find(key)); }
+    const T * find(const Key & key) const { return mappedOf(m_table.find(key)); }
+
+    template<typename K, typename = std::enable_if_t<lookup_as_is<K>>>
+    T * find(const K & key) { return mappedOf(m_table.find(key)); }
+
+    template<typename K, typename = std::enable_if_t<lookup_as_is<K>>>
+    const T * find(const K & key) const { return mappedOf(m_table.find(key)); }
+
+    T & at(const Key & key)
+    {
+        if (auto * p_mapped{find(key)}; likely(nullptr != p_mapped))
+        {
+            return *p_mapped;
+        }
+        throw std::out_of_range{"key not found"};
+    }
+
+    const T & at(const Key & key) const
+    {
+        if (auto * p_mapped{find(key)}; likely(nullptr != p_mapped))
+        {
+            return *p_mapped;
+        }
+        throw std::out_of_range{"key not found"};
+    }
+
+    T & operator[](const Key & key)
+    {
+        return *try_emplace(key).first;
+    }
+
+    T & operator[](Key && key)
+    {
+        return *try_emplace(std::move(key)).first;
+    }
+
+    // constructs the value from args only when key is missing, args are left untouched otherwise
+    template<typename... Args>
+    std::pair<T*, bool> try_emplace(const Key & key, Args&&... args)
+    {
+        return emplaceMapped(key, key, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    std::pair<T*, bool> try_emplace(Key && key, Args&&... args)
+    {
+        return emplaceMapped(key, std::move(key), std::forward<Args>(args)...);
+    }
+
+    template<typename M>
+    std::pair<T*, bool> insert_or_assign(const Key & key, M && obj)
+    {
+        return assignMapped(try_emplace(key, std::forward<M>(obj)), std::forward<M>(obj));
+    }
+
+    template<typename M>
+    std::pair<T*, bool> insert_or_assign(Key && key, M && obj)
+    {
+        return assignMapped(try_emplace(std::move(key), std::forward<M>(obj)), std::forward<M>(obj));
+    }
+
+    bool remove(const Key & key)
+    {
+        return m_table.erase(key);
+    }
+
+    template<typename K, typename = std::enable_if_t<lookup_as_is<K>>>
+    bool remove(const K & key)
+    {
+        return m_table.erase(key);
+    }
+
+    void clear() { m_table.clear(); }
+
+    // makes room for count keys, so that inserting them rehashes at most once here
+    void reserve(std::size_t count) { m_table.reserve(count); }
+
+    // true while an incremental rehash still has old buckets to move
+    bool rehashing() const { return m_table.rehashing(); }
+
+    std::size_t size() const { return m_table.size(); }
+    bool empty() const { return m_table.empty(); }
+    std::size_t bucket_count() const { return m_table.bucket_count(); }
+
+private:
+    // lookupKey is only read before keyArg is consumed, so both may name the same object
+    template<typename KeyArg, typename... Args>
+    std::pair<T*, bool> emplaceMapped(const Key & lookupKey, KeyArg && keyArg, Args&&... args)
+    {
+        auto [p_slot, inserted] = m_table.emplace(lookupKey,
+                                                  std::piecewise_construct,
+                                                  std::forward_as_tuple(std::forward<KeyArg>(keyArg)),
+                                                  std::forward_as_tuple(std::forward<Args>(args)...));
+        return {&p_slot->second, inserted};
+    }
+
+    // a freshly inserted value was built from obj already, only a hit needs the assignment
+    template<typename M>
+    static std::pair<T*, bool> assignMapped(std::pair<T*, bool> result, M && obj)
+    {
+        if (!result.second)
+        {
+            *result.first = std::forward<M>(obj);
+        }
+        return result;
+    }
+
+    static T * mappedOf(slot_type * p_slot) { return p_slot ? &p_slot->second : nullptr; }
+    static const T * mappedOf(const slot_type * p_slot) { return p_slot ? &p_slot->second : nullptr; }
+
+private:
+    table_type m_table;
+};
+
+template<typename Key,
+         std::size_t N = 1,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>,
+         typename BucketPolicy = power_of_two_bucket_policy>
+using small_bucket_unordered_set = unordered_set<Key, Hash, KeyEqual, small_vector<Key, N>, BucketPolicy>;
+
+template<typename Key,
+         std::size_t StepBuckets = 8,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>,
+         typename BucketPolicy = power_of_two_bucket_policy>
+using incremental_unordered_set = unordered_set<Key, Hash, KeyEqual, ds::vector<Key>, BucketPolicy, incremental_rehash_policy<StepBuckets>>;
+
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>,
+         typename BucketPolicy = power_of_two_bucket_policy>
+using cached_hash_unordered_set = unordered_set<Key, Hash, KeyEqual, ds::vector<hashed_value<Key>>, BucketPolicy>;
+
+// rejects most misses with one access to a blocked Bloom filter, before any bucket is touched
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>,
+         typename BucketPolicy = power_of_two_bucket_policy>
+using filtered_unordered_set = unordered_set<Key, Hash, KeyEqual, ds::vector<Key>, BucketPolicy, eager_rehash_policy, bloom_filter<Key, Hash>>;
+
 }//ds
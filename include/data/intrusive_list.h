@@ -0,0 +1,291 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "iterator_facade.h"
+#include "tools.h"
+
+namespace ds
+{
+
+/*
+ * Links embedded in an object so that ds::intrusive_list can chain it
+ * without allocating. Copying an object does not copy its place in a list:
+ * the copy starts unlinked.
+ */
+class intrusive_list_hook
+{
+    template<typename T, intrusive_list_hook T::*Hook>
+    friend class intrusive_list;
+
+public:
+    intrusive_list_hook() = default;
+    intrusive_list_hook(const intrusive_list_hook &) noexcept {}
+    intrusive_list_hook & operator=(const intrusive_list_hook &) noexcept { return *this; }
+
+    bool is_linked() const { return nullptr != p_next; }
+
+private:
+    intrusive_list_hook *p_prev{nullptr};
+    intrusive_list_hook *p_next{nullptr};
+};
+
+/*
+ * Doubly linked list of objects owned elsewhere, chained through the
+ * intrusive_list_hook member Hook of T. Inserting and erasing only relink
+ * hooks: no allocation, copy or move of T, and an object is erased in O(1)
+ * given a reference to it. The list never destroys its elements and an
+ * element must stay alive, and in place, while linked.
+ */
+template<typename T, intrusive_list_hook T::*Hook>
+class intrusive_list
+{
+    using hook = intrusive_list_hook;
+
+    template<bool Const>
+    class node_iterator : public iterator_facade<node_iterator<Const>,
+                                                 std::conditional_t<Const, const T, T>,
+                                                 std::bidirectional_iterator_tag>
+    {
+        friend intrusive_list;
+        friend iterator_facade<node_iterator<Const>,
+                               std::conditional_t<Const, const T, T>,
+                               std::bidirectional_iterator_tag>;
+
+    public:
+        node_iterator() = default;
+
+        template<bool C, typename = std::enable_if_t<Const && !C>>
+        node_iterator(const node_iterator<C> & other) :
+            p_hook{other.p_hook}
+        {}
+
+    protected:
+        explicit node_iterator(hook *p) :
+            p_hook{p}
+        {}
+
+        template<bool C>
+        bool equals(const node_iterator<C> & other) const
+        {
+            return p_hook == other.p_hook;
+        }
+
+        auto & dereference() const
+        {
+            return *intrusive_list::owner(p_hook);
+        }
+
+        void increment()
+        {
+            p_hook = p_hook->p_next;
+        }
+
+        void decrement()
+        {
+            p_hook = p_hook->p_prev;
+        }
+
+    private:
+        hook *p_hook{nullptr};
+    };
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = node_iterator<false>;
+    using const_iterator = node_iterator<true>;
+
+public:
+    intrusive_list()
+    {
+        m_root.p_prev = m_root.p_next = &m_root;
+    }
+
+    intrusive_list(const intrusive_list &) = delete;
+    intrusive_list & operator=(const intrusive_list &) = delete;
+
+    intrusive_list(intrusive_list && other) noexcept :
+        intrusive_list()
+    {
+        adopt(other);
+    }
+
+    intrusive_list & operator=(intrusive_list && other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            adopt(other);
+        }
+        return *this;
+    }
+
+    // unlinks the elements left, without destroying them
+    ~intrusive_list() { clear(); }
+
+public:
+    iterator begin() noexcept { return iterator(m_root.p_next); }
+    const_iterator begin() const noexcept { return const_iterator(m_root.p_next); }
+
+    iterator end() noexcept { return iterator(&m_root); }
+    const_iterator end() const noexcept { return const_iterator(const_cast<hook*>(&m_root)); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    size_type size() const { return m_size; }
+    bool empty() const { return 0 == m_size; }
+
+    reference front() { return *owner(m_root.p_next); }
+    const_reference front() const { return *owner(m_root.p_next); }
+
+    reference back() { return *owner(m_root.p_prev); }
+    const_reference back() const { return *owner(m_root.p_prev); }
+
+    // the position of an element linked in this list
+    iterator iterator_to(reference value) { return iterator(&(value.*Hook)); }
+    const_iterator iterator_to(const_reference value) const { return const_iterator(const_cast<hook*>(&(value.*Hook))); }
+
+    void push_back(reference value) { insert(end(), value); }
+    void push_front(reference value) { insert(begin(), value); }
+
+    void pop_back()
+    {
+        if (!empty())
+        {
+            unlink(m_root.p_prev);
+        }
+    }
+
+    void pop_front()
+    {
+        if (!empty())
+        {
+            unlink(m_root.p_next);
+        }
+    }
+
+    // links value before pos; a value already linked is refused in checked builds
+    iterator insert(iterator pos, reference value)
+    {
+        auto *p_hook{&(value.*Hook)};
+        if constexpr (DS_LIST_CHECKED)
+        {
+            if (p_hook->is_linked())
+            {
+                return end();
+            }
+        }
+
+        auto *p_next{pos.p_hook};
+        p_hook->p_prev = p_next->p_prev;
+        p_hook->p_next = p_next;
+        p_next->p_prev->p_next = p_hook;
+        p_next->p_prev = p_hook;
+        ++m_size;
+        return iterator(p_hook);
+    }
+
+    iterator erase(iterator pos)
+    {
+        if constexpr (DS_LIST_CHECKED)
+        {
+            if (end() == pos || !pos.p_hook->is_linked())
+            {
+                return end();
+            }
+        }
+
+        auto *p_next{pos.p_hook->p_next};
+        unlink(pos.p_hook);
+        return iterator(p_next);
+    }
+
+    // unlinks value, which must be linked in this list
+    void erase(reference value)
+    {
+        erase(iterator_to(value));
+    }
+
+    // moves value, linked in this list, to the front
+    void move_to_front(reference value)
+    {
+        auto *p_hook{&(value.*Hook)};
+        if (m_root.p_next == p_hook)
+        {
+            return;
+        }
+
+        p_hook->p_prev->p_next = p_hook->p_next;
+        p_hook->p_next->p_prev = p_hook->p_prev;
+        p_hook->p_prev = &m_root;
+        p_hook->p_next = m_root.p_next;
+        m_root.p_next->p_prev = p_hook;
+        m_root.p_next = p_hook;
+    }
+
+    void clear()
+    {
+        for (auto *p_hook = m_root.p_next; &m_root != p_hook;)
+        {
+            auto *p_next{p_hook->p_next};
+            p_hook->p_prev = p_hook->p_next = nullptr;
+            p_hook = p_next;
+        }
+        m_root.p_prev = m_root.p_next = &m_root;
+        m_size = 0;
+    }
+
+private:
+    // the element embedding p_hook, found from the offset of Hook inside T
+    static T *owner(hook *p_hook)
+    {
+        return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(p_hook) - hookOffset());
+    }
+
+    // offsetof does not take a member pointer: the offset is read off the member at a fixed
+    // address, which the compiler folds into a constant, so nothing depends on static initialisation
+    static std::ptrdiff_t hookOffset()
+    {
+        constexpr std::uintptr_t base{alignof(T) > 4096 ? alignof(T) : 4096};
+        const auto *p_object{reinterpret_cast<const T*>(base)};
+        return static_cast<std::ptrdiff_t>(reinterpret_cast<std::uintptr_t>(&(p_object->*Hook)) - base);
+    }
+
+    void unlink(hook *p_hook)
+    {
+        p_hook->p_prev->p_next = p_hook->p_next;
+        p_hook->p_next->p_prev = p_hook->p_prev;
+        p_hook->p_prev = p_hook->p_next = nullptr;
+        --m_size;
+    }
+
+    // takes over the elements of other, expects this list empty
+    void adopt(intrusive_list & other)
+    {
+        if (other.empty())
+        {
+            return;
+        }
+
+        m_root.p_prev = other.m_root.p_prev;
+        m_root.p_next = other.m_root.p_next;
+        m_root.p_next->p_prev = &m_root;
+        m_root.p_prev->p_next = &m_root;
+        m_size = std::exchange(other.m_size, 0);
+        other.m_root.p_prev = other.m_root.p_next = &other.m_root;
+    }
+
+private:
+    hook m_root;
+    size_type m_size{0};
+};
+
+}//ds
@@ -1,7 +1,11 @@
 #pragma once
 #include <memory>
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <type_traits>
+#include <utility>
 #include <cstdio>
 #include <iostream>
 
@@ -40,8 +44,26 @@ class list
     template<IteratorOperation Op>
     struct wrap{};
 
-    struct node : object_storage<T>
+    static constexpr bool checked_ownership{DS_LIST_CHECKED};
+
+    struct owner_id
+    {
+        explicit owner_id(std::size_t internalId) : id{internalId} {}
+        bool ownedBy(std::size_t listId) const { return id == listId; }
+
+        std::size_t id;
+    };
+
+    // empty, so that the node is no larger than its value and links
+    struct no_owner_id
     {
+        explicit no_owner_id(std::size_t) {}
+        bool ownedBy(std::size_t) const { return true; }
+    };
+
+    struct node : object_storage<T>, std::conditional_t<checked_ownership, owner_id, no_owner_id>
+    {
+        using owner = std::conditional_t<checked_ownership, owner_id, no_owner_id>;
         using size_type = typename list::size_type;
         using value_type = typename list::value_type;
         using node_pointer = typename list::node_pointer;
@@ -49,12 +71,11 @@ class list
         node_pointer prev{nullptr};
         node_pointer next{nullptr};
 //        T value;
-        size_type id;
 
         node(size_type internalId, node_pointer pPrev = nullptr, node_pointer pNext = nullptr) :
+            owner{internalId},
             prev{pPrev},
-            next{pNext},
-            id{internalId}
+            next{pNext}
         {}
 
         /*
@@ -75,7 +96,14 @@ class list
 
         friend bool operator==(const node & lhs, const node & rhs)
         {
-            return lhs.id == rhs.id && lhs.next == rhs.next && lhs.prev == rhs.prev;
+            if constexpr (checked_ownership)
+            {
+                if (lhs.id != rhs.id)
+                {
+                    return false;
+                }
+            }
+            return lhs.next == rhs.next && lhs.prev == rhs.prev;
         }
     };
 
@@ -201,7 +229,6 @@ public:
        m_id = other.m_id;
        constexpr bool pocma{std::allocator_traits<node_allocator>::propagate_on_container_move_assignment::value};
        if constexpr (pocma){
-           std::cout << "list::operator=(list&&) pocma\n";
            m_alloc = other.m_alloc;
            m_header = std::exchange(other.m_header, nullptr);
            m_tail = std::exchange(other.m_tail, nullptr);
@@ -389,8 +416,234 @@ public:
            clear(p_node);
            --m_size;
        }
+       m_header->next = m_tail;
+       m_tail->prev = m_header;
     }
-   
+
+    /*
+     * splice, merge, sort, reverse and unique relink nodes and never copy,
+     * move or allocate elements. Nodes taken from other must be freed by this
+     * list's allocator: the two allocators must compare equal.
+     */
+
+    // moves all the elements of other before pos
+    void splice(iterator pos, list & other)
+    {
+        if (this == &other || other.empty() || !validate(pos, wrap<IteratorOperation::InsertBefore>{}))
+        {
+            return;
+        }
+
+        auto count{other.m_size};
+        transfer(pos.current_node, other, other.frontNode(), other.backNode(), count);
+    }
+
+    void splice(iterator pos, list && other)
+    {
+        splice(pos, other);
+    }
+
+    // moves the element at it, which belongs to other, before pos
+    void splice(iterator pos, list & other, iterator it)
+    {
+        if (!validate(pos, wrap<IteratorOperation::InsertBefore>{}) ||
+            !other.validate(it, wrap<IteratorOperation::EraseAt>{}) ||
+            pos.current_node == it.current_node || pos.current_node == it.current_node->next)
+        {
+            return;
+        }
+        transfer(pos.current_node, other, it.current_node, it.current_node, 1);
+    }
+
+    void splice(iterator pos, list && other, iterator it)
+    {
+        splice(pos, other, it);
+    }
+
+    // moves [first, last) of other before pos, which must not lie inside the range; linear in the range length
+    // unless other is this list
+    void splice(iterator pos, list & other, iterator first, iterator last)
+    {
+        if (first == last || !validate(pos, wrap<IteratorOperation::InsertBefore>{}) ||
+            !other.validate(first, wrap<IteratorOperation::EraseAt>{}))
+        {
+            return;
+        }
+
+        size_type count{0};
+        if (this != &other)
+        {
+            count = static_cast<size_type>(std::distance(first, last));
+        }
+        transfer(pos.current_node, other, first.current_node, last.current_node->prev, count);
+    }
+
+    void splice(iterator pos, list && other, iterator first, iterator last)
+    {
+        splice(pos, other, first, last);
+    }
+
+    // merges the sorted other into this sorted list, stable: equal elements of this list come first
+    template<typename Compare>
+    void merge(list & other, Compare comp)
+    {
+        if (this == &other || other.empty())
+        {
+            return;
+        }
+
+        auto p_node{frontNode()};
+        auto p_other{other.frontNode()};
+        while (p_other != other.m_tail)
+        {
+            if (p_node == m_tail || comp(*(p_other->get()), *(p_node->get())))
+            {
+                // takes the whole run of other which sorts before p_node at once
+                auto p_last{p_other};
+                while (p_last->next != other.m_tail && (p_node == m_tail || comp(*(p_last->next->get()), *(p_node->get()))))
+                {
+                    p_last = p_last->next;
+                }
+                auto p_next{p_last->next};
+                link(p_node, p_other, p_last);
+                adopt(p_other, p_last);
+                p_other = p_next;
+            }
+            else
+            {
+                p_node = p_node->next;
+            }
+        }
+
+        m_size += std::exchange(other.m_size, 0);
+        other.m_header->next = other.m_tail;
+        other.m_tail->prev = other.m_header;
+    }
+
+    void merge(list & other)
+    {
+        merge(other, std::less<>{});
+    }
+
+    template<typename Compare>
+    void merge(list && other, Compare comp)
+    {
+        merge(other, comp);
+    }
+
+    void merge(list && other)
+    {
+        merge(other);
+    }
+
+    /*
+     * Stable bottom-up merge sort. The nodes are detached as a singly linked
+     * chain and merged into runs kept in bins, bin i holding a sorted run of
+     * 2^i nodes, so the only extra storage is the bin array on the stack. The
+     * prev links are rebuilt in a final pass between m_header and m_tail.
+     */
+    template<typename Compare>
+    void sort(Compare comp)
+    {
+        if (m_size < 2)
+        {
+            return;
+        }
+
+        m_tail->prev->next = nullptr;
+        node_pointer bins[std::numeric_limits<size_type>::digits]{};
+        size_type usedBins{0};
+        for (auto p_node = frontNode(); nullptr != p_node;)
+        {
+            auto p_carry{std::exchange(p_node, p_node->next)};
+            p_carry->next = nullptr;
+
+            size_type i{0};
+            for (; nullptr != bins[i]; ++i)
+            {
+                p_carry = mergeRuns(std::exchange(bins[i], nullptr), p_carry, comp);
+            }
+            bins[i] = p_carry;
+            usedBins = std::max(usedBins, i + 1);
+        }
+
+        // lower bins hold the later elements
+        node_pointer p_sorted{nullptr};
+        for (size_type i = 0; i < usedBins; ++i)
+        {
+            if (nullptr != bins[i])
+            {
+                p_sorted = nullptr == p_sorted ? bins[i] : mergeRuns(bins[i], p_sorted, comp);
+            }
+        }
+
+        auto p_prev{m_header};
+        for (auto p_node = p_sorted; nullptr != p_node; p_node = p_node->next)
+        {
+            p_node->prev = p_prev;
+            p_prev->next = p_node;
+            p_prev = p_node;
+        }
+        p_prev->next = m_tail;
+        m_tail->prev = p_prev;
+    }
+
+    void sort()
+    {
+        sort(std::less<>{});
+    }
+
+    void reverse()
+    {
+        if (m_size < 2)
+        {
+            return;
+        }
+
+        auto p_front{frontNode()};
+        auto p_back{backNode()};
+        for (auto p_node = p_front; p_node != m_tail;)
+        {
+            auto p_next{p_node->next};
+            std::swap(p_node->prev, p_node->next);
+            p_node = p_next;
+        }
+        m_header->next = p_back;
+        p_back->prev = m_header;
+        m_tail->prev = p_front;
+        p_front->next = m_tail;
+    }
+
+    // removes all but the first of every run of consecutive equivalent elements, returns how many were removed
+    template<typename BinaryPredicate>
+    size_type unique(BinaryPredicate pred)
+    {
+        size_type removed{0};
+        if (m_size < 2)
+        {
+            return removed;
+        }
+
+        for (auto p_node = frontNode(); p_node->next != m_tail;)
+        {
+            if (pred(*(p_node->get()), *(p_node->next->get())))
+            {
+                eraseAt(p_node->next);
+                ++removed;
+            }
+            else
+            {
+                p_node = p_node->next;
+            }
+        }
+        return removed;
+    }
+
+    size_type unique()
+    {
+        return unique(std::equal_to<>{});
+    }
+
 protected:
     template<typename... Args>
     node_pointer create(size_type internalId, node_pointer pPrev,
@@ -484,6 +737,63 @@ protected:
         return p_next;
     }
 
+    // links the chain [p_first, p_last] before p_pos
+    static void link(node_pointer p_pos, node_pointer p_first, node_pointer p_last)
+    {
+        p_first->prev->next = p_last->next;
+        p_last->next->prev = p_first->prev;
+
+        p_first->prev = p_pos->prev;
+        p_last->next = p_pos;
+        p_pos->prev->next = p_first;
+        p_pos->prev = p_last;
+    }
+
+    // in checked builds the nodes taken from another list change owner
+    void adopt([[maybe_unused]] node_pointer p_first, [[maybe_unused]] node_pointer p_last)
+    {
+        if constexpr (checked_ownership)
+        {
+            for (auto p_node = p_first; ; p_node = p_node->next)
+            {
+                p_node->id = m_id;
+                if (p_node == p_last)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    // moves the count nodes [p_first, p_last] of other before p_pos
+    void transfer(node_pointer p_pos, list & other, node_pointer p_first, node_pointer p_last, size_type count)
+    {
+        link(p_pos, p_first, p_last);
+        if (this != &other)
+        {
+            adopt(p_first, p_last);
+            other.m_size -= count;
+            m_size += count;
+        }
+    }
+
+    // merges two null terminated sorted chains, on ties the node of p_first comes first
+    template<typename Compare>
+    static node_pointer mergeRuns(node_pointer p_first, node_pointer p_second, Compare & comp)
+    {
+        node_pointer p_head{nullptr};
+        auto *p_link{&p_head};
+        while (nullptr != p_first && nullptr != p_second)
+        {
+            auto & p_taken{comp(*(p_second->get()), *(p_first->get())) ? p_second : p_first};
+            *p_link = p_taken;
+            p_link = &p_taken->next;
+            p_taken = p_taken->next;
+        }
+        *p_link = nullptr != p_first ? p_first : p_second;
+        return p_head;
+    }
+
     void buildSentinelNodes()
     {
         m_header = create(m_id, nullptr, nullptr);
@@ -495,7 +805,7 @@ protected:
     bool validate(node_iterator<Const> pos, [[maybe_unused]] wrap<IteratorOperation::InsertAfter> op)
     {
        auto node_pos = pos.current_node;
-       if (nullptr == node_pos || node_pos->id != m_id)
+       if (nullptr == node_pos || !node_pos->ownedBy(m_id))
        {
            return false;
        }
@@ -507,7 +817,7 @@ protected:
     bool validate(node_iterator<Const> pos, [[maybe_unused]] wrap<IteratorOperation::InsertBefore> op)
     {
        auto node_pos = pos.current_node;
-       if (nullptr == node_pos || node_pos->id != m_id)
+       if (nullptr == node_pos || !node_pos->ownedBy(m_id))
        {
            return false;
        }
@@ -525,7 +835,7 @@ protected:
         }
 
         auto node_pos = pos.current_node;
-        if (nullptr == node_pos || node_pos->id != m_id)
+        if (nullptr == node_pos || !node_pos->ownedBy(m_id))
         {
             return false;
         }
@@ -535,6 +845,11 @@ protected:
             return false;
         }
 
+        if constexpr (!checked_ownership)
+        {
+            return true;
+        }
+
         auto prev_pos = node_pos->prev;
         auto next_pos = node_pos->next;
 
@@ -543,7 +858,17 @@ protected:
     }
     
 private:
-    size_type m_id{ts::getRandomNumberInMinMaxRange<size_type>()};
+    static size_type newId()
+    {
+        if constexpr (checked_ownership)
+        {
+            return ts::getRandomNumberInMinMaxRange<size_type>();
+        }
+        return 0;
+    }
+
+private:
+    size_type m_id{newId()};
     size_type m_size{0};
     node_allocator m_alloc{};
     node_pointer m_header{nullptr};
@@ -0,0 +1,194 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ds
+{
+
+namespace detail
+{
+
+/*
+ * Fixed size block pool: blocks are carved one after the other from chunks
+ * of BlocksPerChunk blocks and freed blocks are threaded on a free list,
+ * which is served first. Chunks are returned to the system only when the
+ * pool is destroyed. Not thread safe.
+ */
+template<std::size_t BlocksPerChunk>
+class node_pool
+{
+    struct free_block
+    {
+        free_block *p_next;
+    };
+
+    // chunks are linked through a header placed in front of their blocks
+    struct chunk_header
+    {
+        chunk_header *p_previous;
+    };
+
+public:
+    node_pool(std::size_t blockSize, std::size_t alignment) :
+        m_alignment{std::max({alignment, alignof(free_block), alignof(chunk_header)})},
+        m_blockSize{roundUp(std::max(blockSize, sizeof(free_block)), m_alignment)},
+        m_headerSize{roundUp(sizeof(chunk_header), m_alignment)}
+    {}
+
+    node_pool(const node_pool &) = delete;
+    node_pool & operator=(const node_pool &) = delete;
+
+    ~node_pool()
+    {
+        while (nullptr != m_chunks)
+        {
+            auto *p_previous{m_chunks->p_previous};
+            ::operator delete(m_chunks, std::align_val_t{m_alignment});
+            m_chunks = p_previous;
+        }
+    }
+
+    bool serves(std::size_t size, std::size_t alignment) const
+    {
+        return size <= m_blockSize && alignment <= m_alignment;
+    }
+
+    void *allocate()
+    {
+        if (nullptr != m_free)
+        {
+            return std::exchange(m_free, m_free->p_next);
+        }
+
+        if (m_next == m_end)
+        {
+            addChunk();
+        }
+        return std::exchange(m_next, m_next + m_blockSize);
+    }
+
+    void deallocate(void *p) noexcept
+    {
+        m_free = ::new(p) free_block{m_free};
+    }
+
+private:
+    static std::size_t roundUp(std::size_t size, std::size_t alignment)
+    {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    void addChunk()
+    {
+        auto *p_chunk{static_cast<std::byte*>(::operator new(m_headerSize + BlocksPerChunk * m_blockSize,
+                                                             std::align_val_t{m_alignment}))};
+        m_chunks = ::new(p_chunk) chunk_header{m_chunks};
+        m_next = p_chunk + m_headerSize;
+        m_end = m_next + BlocksPerChunk * m_blockSize;
+    }
+
+private:
+    std::size_t m_alignment;
+    std::size_t m_blockSize;
+    std::size_t m_headerSize;
+    free_block *m_free{nullptr};
+    std::byte *m_next{nullptr};
+    std::byte *m_end{nullptr};
+    chunk_header *m_chunks{nullptr};
+};
+
+// lets rebound copies of an allocator agree on the pool before any of them allocates
+template<std::size_t BlocksPerChunk>
+struct node_pool_handle
+{
+    std::unique_ptr<node_pool<BlocksPerChunk>> p_pool;
+};
+
+}//detail
+
+/*
+ * Node allocator for ds::list and other node based containers.
+ * Single object allocations come from a pool of blocks carved contiguously
+ * from large chunks and recycled through a free list, so neighbouring nodes
+ * share cache lines and an insert costs a pointer bump instead of a malloc.
+ * Copies and rebinds share the pool, whose block size is fixed by the first
+ * single object allocation; array allocations and objects of another size go
+ * to operator new. Equal allocators share a pool. Not thread safe.
+ */
+template<typename T, std::size_t BlocksPerChunk = 1024>
+class pool_allocator
+{
+    template<typename U, std::size_t N>
+    friend class pool_allocator;
+
+    using pool_type = detail::node_pool<BlocksPerChunk>;
+    using pool_handle = detail::node_pool_handle<BlocksPerChunk>;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = pool_allocator<U, BlocksPerChunk>;
+    };
+
+public:
+    pool_allocator() :
+        m_handle{std::make_shared<pool_handle>()}
+    {}
+
+    template<typename U>
+    pool_allocator(const pool_allocator<U, BlocksPerChunk> & other) noexcept :
+        m_handle{other.m_handle}
+    {}
+
+    T *allocate(size_type count)
+    {
+        if (1 == count)
+        {
+            auto & p_pool{m_handle->p_pool};
+            if (nullptr == p_pool)
+            {
+                p_pool = std::make_unique<pool_type>(sizeof(T), alignof(T));
+            }
+
+            if (p_pool->serves(sizeof(T), alignof(T)))
+            {
+                return static_cast<T*>(p_pool->allocate());
+            }
+        }
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{alignof(T)}));
+    }
+
+    void deallocate(T *p, size_type count) noexcept
+    {
+        const auto & p_pool{m_handle->p_pool};
+        if (1 == count && p_pool->serves(sizeof(T), alignof(T)))
+        {
+            p_pool->deallocate(p);
+        }
+        else
+        {
+            ::operator delete(p, std::align_val_t{alignof(T)});
+        }
+    }
+
+    template<typename U>
+    bool operator==(const pool_allocator<U, BlocksPerChunk> & other) const noexcept { return m_handle == other.m_handle; }
+
+    template<typename U>
+    bool operator!=(const pool_allocator<U, BlocksPerChunk> & other) const noexcept { return m_handle != other.m_handle; }
+
+private:
+    std::shared_ptr<pool_handle> m_handle;
+};
+
+}//ds
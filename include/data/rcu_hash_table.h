@@ -0,0 +1,226 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include "epoch_manager.h"
+#include "hash_table.h"
+
+namespace ds
+{
+
+/*
+ * Read-mostly set whose lookups take no lock and perform no read-modify-write:
+ * a lookup enters an epoch guard and follows two acquire loads, the table and
+ * then the bucket. Buckets are immutable once published. A writer, serialized
+ * by a mutex, copies the bucket it changes, publishes the copy and retires the
+ * original; growing publishes a whole new table and retires the old one with
+ * its buckets. Retired memory is freed by the epoch_manager once no reader can
+ * still hold it.
+ */
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>,
+         typename BucketPolicy = power_of_two_bucket_policy>
+class rcu_unordered_set
+{
+    static_assert(!ts::is_reference_v<Key>, "rcu_unordered_set error: type reference not allowed");
+
+    using Bucket = ds::vector<Key>;
+
+    template<typename K>
+    static constexpr bool lookup_as_is{(ts::is_transparent_v<Hash> && ts::is_transparent_v<KeyEqual>) || std::is_same_v<std::decay_t<K>, Key>};
+
+    // a null bucket is an empty one
+    struct table
+    {
+        explicit table(std::size_t count) :
+            bucketCount{count},
+            buckets{new std::atomic<const Bucket*>[count]()}
+        {}
+
+        std::size_t bucketCount;
+        std::unique_ptr<std::atomic<const Bucket*>[]> buckets;
+    };
+
+    // a table owns the buckets it still points to
+    struct table_deleter
+    {
+        void operator()(table *p_table) const
+        {
+            for (std::size_t i = 0; i < p_table->bucketCount; ++i)
+            {
+                delete p_table->buckets[i].load(std::memory_order_relaxed);
+            }
+            delete p_table;
+        }
+    };
+
+public:
+    explicit rcu_unordered_set(std::size_t size = 101, epoch_manager & epochs = epoch_manager::global()) :
+        m_epochs{epochs},
+        m_table{new table(BucketPolicy::bucketCount(size))}
+    {}
+
+    rcu_unordered_set(const rcu_unordered_set &) = delete;
+    rcu_unordered_set & operator=(const rcu_unordered_set &) = delete;
+
+    // no reader may still be running
+    ~rcu_unordered_set()
+    {
+        table_deleter{}(m_table.load(std::memory_order_relaxed));
+    }
+
+public:
+    bool contains(const Key & value) const
+    {
+        return find(value);
+    }
+
+    template<typename K, typename = std::enable_if_t<lookup_as_is<K>>>
+    bool contains(const K & value) const
+    {
+        return find(value);
+    }
+
+    template<typename K>
+    bool insert(K && value)
+    {
+        std::lock_guard lock{m_writeMutex};
+        auto *p_table{m_table.load(std::memory_order_relaxed)};
+        auto & slot{p_table->buckets[bucketIndex(m_hash(value), p_table->bucketCount)]};
+        const auto *p_old{slot.load(std::memory_order_relaxed)};
+        if (p_old && contains(*p_old, value, m_equal))
+        {
+            return false;
+        }
+
+        auto *p_new{p_old ? new Bucket(*p_old) : new Bucket()};
+        p_new->push_back(Key(std::forward<K>(value)));
+        slot.store(p_new, std::memory_order_release);
+        if (p_old)
+        {
+            m_epochs.retire(p_old);
+        }
+
+        auto size{m_size.load(std::memory_order_relaxed) + 1};
+        m_size.store(size, std::memory_order_relaxed);
+        if (size >= p_table->bucketCount)
+        {
+            rehash(p_table, BucketPolicy::nextBucketCount(p_table->bucketCount));
+        }
+        return true;
+    }
+
+    bool remove(const Key & value)
+    {
+        return erase(value);
+    }
+
+    template<typename K, typename = std::enable_if_t<lookup_as_is<K>>>
+    bool remove(const K & value)
+    {
+        return erase(value);
+    }
+
+    std::size_t size() const { return m_size.load(std::memory_order_relaxed); }
+    bool empty() const { return 0 == size(); }
+
+    std::size_t bucket_count() const
+    {
+        epoch_manager::guard guard{m_epochs};
+        return m_table.load(std::memory_order_acquire)->bucketCount;
+    }
+
+private:
+    template<typename K>
+    bool find(const K & value) const
+    {
+        epoch_manager::guard guard{m_epochs};
+        const auto *p_table{m_table.load(std::memory_order_acquire)};
+        const auto *p_bucket{p_table->buckets[bucketIndex(m_hash(value), p_table->bucketCount)].load(std::memory_order_acquire)};
+        return p_bucket && contains(*p_bucket, value, m_equal);
+    }
+
+    template<typename K>
+    bool erase(const K & value)
+    {
+        std::lock_guard lock{m_writeMutex};
+        auto *p_table{m_table.load(std::memory_order_relaxed)};
+        auto & slot{p_table->buckets[bucketIndex(m_hash(value), p_table->bucketCount)]};
+        const auto *p_old{slot.load(std::memory_order_relaxed)};
+        if (!p_old || !contains(*p_old, value, m_equal))
+        {
+            return false;
+        }
+
+        Bucket *p_new{nullptr};
+        if (p_old->size() > 1)
+        {
+            p_new = new Bucket();
+            p_new->reserve(p_old->size() - 1);
+            for (const auto & key : *p_old)
+            {
+                if (!m_equal(value, key))
+                {
+                    p_new->push_back(key);
+                }
+            }
+        }
+        slot.store(p_new, std::memory_order_release);
+        m_epochs.retire(p_old);
+        m_size.store(m_size.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    template<typename K>
+    static bool contains(const Bucket & bucket, const K & value, const KeyEqual & equal)
+    {
+        return std::end(bucket) != std::find_if(std::begin(bucket), std::end(bucket), [&equal, &value](const auto & key){
+                                                return equal(value, key); });
+    }
+
+    static std::size_t bucketIndex(std::size_t hash, std::size_t bucketCount)
+    {
+        return BucketPolicy::index(hash, bucketCount);
+    }
+
+    // expects m_writeMutex held; readers keep using the old table until the new one is published
+    void rehash(table *p_old, std::size_t bucketCount)
+    {
+        auto p_new{std::make_unique<table>(bucketCount)};
+        for (std::size_t i = 0; i < p_old->bucketCount; ++i)
+        {
+            const auto *p_bucket{p_old->buckets[i].load(std::memory_order_relaxed)};
+            if (!p_bucket)
+            {
+                continue;
+            }
+
+            for (const auto & key : *p_bucket)
+            {
+                auto & slot{p_new->buckets[bucketIndex(m_hash(key), bucketCount)]};
+                auto *p_dest{const_cast<Bucket*>(slot.load(std::memory_order_relaxed))};
+                if (!p_dest)
+                {
+                    p_dest = new Bucket();
+                    slot.store(p_dest, std::memory_order_relaxed);
+                }
+                p_dest->push_back(key);
+            }
+        }
+
+        m_table.store(p_new.release(), std::memory_order_release);
+        m_epochs.retire(p_old, table_deleter{});
+    }
+
+private:
+    epoch_manager & m_epochs;
+    std::atomic<table*> m_table;
+    std::atomic<std::size_t> m_size{0};
+    std::mutex m_writeMutex;
+    Hash m_hash{};
+    KeyEqual m_equal{};
+};
+
+}//ds
@@ -0,0 +1,136 @@
+#pragma once
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace ds
+{
+
+/*
+ * Allocator for buffers of trivially relocatable elements which can be
+ * resized in place through reallocate().
+ * Blocks smaller than MmapThreshold bytes come from malloc/realloc; larger
+ * blocks are mapped directly so that growing them is an mremap of the page
+ * tables instead of a copy into a second buffer of twice the size.
+ */
+template<typename T, std::size_t MmapThreshold = 1024*1024>
+class remap_allocator
+{
+    static_assert(std::is_trivially_copyable_v<T>, "remap_allocator error: elements are moved bytewise");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = remap_allocator<U, MmapThreshold>;
+    };
+
+public:
+    remap_allocator() = default;
+
+    template<typename U>
+    remap_allocator(const remap_allocator<U, MmapThreshold> &) noexcept
+    {}
+
+    T *allocate(size_type count)
+    {
+        auto bytes{count * sizeof(T)};
+        void *p{nullptr};
+        if (isMapped(bytes))
+        {
+            p = ::mmap(nullptr, pageAligned(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (MAP_FAILED == p)
+            {
+                throw std::bad_alloc{};
+            }
+        }
+        else if (p = std::malloc(std::max<size_type>(bytes, 1)); nullptr == p)
+        {
+            throw std::bad_alloc{};
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T *p, size_type count) noexcept
+    {
+        if (nullptr == p)
+        {
+            return;
+        }
+
+        auto bytes{count * sizeof(T)};
+        if (isMapped(bytes))
+        {
+            ::munmap(p, pageAligned(bytes));
+        }
+        else
+        {
+            std::free(p);
+        }
+    }
+
+    // the first min(oldCount, newCount) elements are preserved bytewise;
+    // the block may move, the returned pointer replaces p
+    T *reallocate(T *p, size_type oldCount, size_type newCount)
+    {
+        if (nullptr == p)
+        {
+            return allocate(newCount);
+        }
+
+        auto oldBytes{oldCount * sizeof(T)};
+        auto newBytes{newCount * sizeof(T)};
+        void *p_new{nullptr};
+
+        if (isMapped(oldBytes) && isMapped(newBytes))
+        {
+            p_new = ::mremap(p, pageAligned(oldBytes), pageAligned(newBytes), MREMAP_MAYMOVE);
+            if (MAP_FAILED == p_new)
+            {
+                throw std::bad_alloc{};
+            }
+        }
+        else if (!isMapped(oldBytes) && !isMapped(newBytes))
+        {
+            if (p_new = std::realloc(p, std::max<size_type>(newBytes, 1)); nullptr == p_new)
+            {
+                throw std::bad_alloc{};
+            }
+        }
+        else
+        {
+            // crossing the threshold changes the backing, a single copy is unavoidable
+            p_new = allocate(newCount);
+            std::memcpy(p_new, p, std::min(oldBytes, newBytes));
+            deallocate(p, oldCount);
+        }
+        return static_cast<T*>(p_new);
+    }
+
+    template<typename U>
+    bool operator==(const remap_allocator<U, MmapThreshold> &) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const remap_allocator<U, MmapThreshold> &) const noexcept { return false; }
+
+private:
+    static bool isMapped(size_type bytes) { return bytes >= MmapThreshold; }
+
+    static size_type pageAligned(size_type bytes)
+    {
+        static const size_type pageSize{static_cast<size_type>(::sysconf(_SC_PAGESIZE))};
+        return (bytes + pageSize - 1) & ~(pageSize - 1);
+    }
+};
+
+}//ds
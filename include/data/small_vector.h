@@ -0,0 +1,418 @@
+#pragma once
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.h"
+#include "iterator_facade.h"
+#include "traits.h"
+#include "tools.h"
+#include "base_member_pair.hpp"
+
+namespace ds
+{
+
+/*
+ * Vector keeping its first N elements in an inline buffer.
+ * The allocator is only used once the size exceeds N; from then on the
+ * elements live on the heap exactly like in ds::vector and share its
+ * gap and relocation routines.
+ */
+template<typename T,
+         std::size_t N,
+         typename Allocator = std::allocator<T>>
+class small_vector
+{
+    static_assert(!ts::is_reference_v<T>, "small_vector error: type reference not allowed");
+    static_assert(N > 0, "small_vector error: inline capacity must not be zero");
+
+    template<bool>
+    class internal_iterator;
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename alloc_traits::pointer;
+    using const_pointer = typename alloc_traits::const_pointer;
+    using iterator = internal_iterator<false>;
+    using const_iterator = internal_iterator<true>;
+
+    static constexpr size_type inline_capacity{N};
+
+private:
+    template<bool Const>
+    class internal_iterator : public iterator_facade<internal_iterator<Const>,
+                                                     std::conditional_t<Const, const T, T>,
+                                                     std::random_access_iterator_tag>
+    {
+        using base = iterator_facade<internal_iterator<Const>, std::conditional_t<Const, const T, T>, std::random_access_iterator_tag>;
+
+        friend iterator_facade<internal_iterator<Const>, std::conditional_t<Const, const T, T>, std::random_access_iterator_tag>;
+        friend small_vector;
+
+    public:
+        using value_type = typename base::value_type;
+        using reference = typename base::reference;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using difference_type = typename small_vector::difference_type;
+        using iterator_category = typename base::iterator_category;
+
+        internal_iterator(const internal_iterator<false> & other) :
+            p_value{other.p_value}
+        {}
+
+    protected:
+        internal_iterator(pointer p) :
+            p_value{p}
+        {}
+
+        template<bool C>
+        bool equals(const internal_iterator<C> & other) const
+        {
+            return p_value == other.p_value;
+        }
+
+        __attribute__((always_inline)) auto & dereference() const
+        {
+            return *p_value;
+        }
+
+        void increment()
+        {
+            ++p_value;
+        }
+
+        void decrement()
+        {
+            --p_value;
+        }
+
+        void advance(difference_type n)
+        {
+            p_value += n;
+        }
+
+        template<bool C>
+        difference_type measureDistance(const internal_iterator<C> & other) const
+        {
+            return p_value - other.p_value;
+        }
+
+    protected:
+        pointer item() const { return p_value; }
+
+    private:
+        template<bool>
+        friend class internal_iterator;
+
+        pointer p_value;
+    };
+
+public:
+    small_vector(const Allocator & alloc = Allocator()) :
+        m_compressedPair(alloc, 0)
+    {}
+
+    small_vector(std::initializer_list<T> ilist, const Allocator & alloc = Allocator()) :
+        m_compressedPair(alloc, 0)
+    {
+        reserve(ilist.size());
+        for (const auto & value : ilist)
+        {
+            push_back(value);
+        }
+    }
+
+    small_vector(const small_vector & other) :
+        m_compressedPair(alloc_traits::select_on_container_copy_construction(other.getAlloc()), 0)
+    {
+        reserve(other.size());
+        for (const auto & value : other)
+        {
+            push_back(value);
+        }
+    }
+
+    small_vector(small_vector && other) :
+        m_compressedPair(other.getAlloc(), 0)
+    {
+        takeElements(other);
+    }
+
+    ~small_vector()
+    {
+        clear();
+        releaseStorage();
+    }
+
+    small_vector & operator=(const small_vector & other)
+    {
+        if (this != &other)
+        {
+            clear();
+            constexpr bool pocca{alloc_traits::propagate_on_container_copy_assignment::value};
+            if constexpr (pocca){
+                releaseStorage();
+                getAlloc() = other.getAlloc();
+            }
+
+            reserve(other.size());
+            for (const auto & value : other)
+            {
+                push_back(value);
+            }
+        }
+        return *this;
+    }
+
+    small_vector & operator=(small_vector && other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        clear();
+        constexpr bool pocma{alloc_traits::propagate_on_container_move_assignment::value};
+        if constexpr (pocma){
+            releaseStorage();
+            getAlloc() = other.getAlloc();
+            takeElements(other);
+        }
+        else if (getAlloc() == other.getAlloc()){
+            releaseStorage();
+            takeElements(other);
+        }
+        else{
+            reserve(other.size());
+            for (auto & value : other)
+            {
+                push_back(std::move(value));
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    void swap(small_vector & other)
+    {
+        auto temp = std::move(*this);
+        *this = std::move(other);
+        other = std::move(temp);
+    }
+
+    void push_back(const T & value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T && value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    template<typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        auto & size{getSize()};
+        if (unlikely(size == m_capacity))
+        {
+            growStorage(m_capacity * 2);
+        }
+
+        T *raw_p = std::addressof(m_pArray[size]);
+        alloc_traits::construct(getAlloc(), raw_p, std::forward<Args>(args)...);
+        ++size;
+        return *raw_p;
+    }
+
+    void pop_back()
+    {
+        auto & size{getSize()};
+        if (likely(0 != size))
+        {
+            T *raw_p = std::addressof(m_pArray[size-1]);
+            alloc_traits::destroy(getAlloc(), raw_p);
+            --size;
+        }
+    }
+
+    // destroys the elements, the storage (inline or spilled) is kept
+    void clear()
+    {
+        auto & size{getSize()};
+        if constexpr (!std::is_trivially_destructible_v<value_type>)
+        {
+            auto & alloc = getAlloc();
+            for (size_type i = 0; i < size; ++i)
+            {
+                alloc_traits::destroy(alloc, std::addressof(m_pArray[i]));
+            }
+        }
+        size = 0;
+    }
+
+    void reserve(size_type capacity)
+    {
+        if (capacity > m_capacity)
+        {
+            growStorage(ts::nextLargerPowerOf2(capacity));
+        }
+    }
+
+    template<bool C>
+    iterator insert(internal_iterator<C> pos, const T & value)
+    {
+        return iterator(emplace(pos.item(), value));
+    }
+
+    template<bool C>
+    iterator insert(internal_iterator<C> pos, T && value)
+    {
+        return iterator(emplace(pos.item(), std::move(value)));
+    }
+
+    template<bool C>
+    iterator erase(internal_iterator<C> pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    template<bool C>
+    iterator erase(internal_iterator<C> first, internal_iterator<C> last)
+    {
+        auto erasureIndex{static_cast<size_type>(first.item() - startPtr())};
+        auto erasureSize{static_cast<size_type>(last.item() - first.item())};
+        auto & size{getSize()};
+        if (unlikely(erasureIndex + erasureSize > size))
+        {
+            return end();
+        }
+
+        detail::closeGap(getAlloc(), startPtr(), size, erasureIndex, erasureSize);
+        size -= erasureSize;
+        return iterator(startPtr() + erasureIndex);
+    }
+
+    iterator begin() noexcept { return iterator(startPtr()); }
+    const_iterator begin() const noexcept { return const_iterator(startPtr()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(endPtr()); }
+    const_iterator end() const noexcept { return const_iterator(endPtr()); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reference front() { return *startPtr(); }
+    const_reference front() const { return *startPtr(); }
+    reference back() { return *(endPtr() - 1); }
+    const_reference back() const { return *(endPtr() - 1); }
+
+    reference at(size_type pos) {
+        if (likely(pos < getSize())){
+            return operator[](pos);
+        }
+        throw std::out_of_range{"index out of bounds"};
+    }
+
+    const_reference at(size_type pos) const {
+        if (likely(pos < getSize())){
+            return operator[](pos);
+        }
+        throw std::out_of_range{"index out of bounds"};
+    }
+
+    reference operator[](size_type pos) { return m_pArray[pos]; }
+    const_reference operator[](size_type pos) const { return m_pArray[pos]; }
+
+    bool empty() const { return 0 == getSize(); }
+    size_type size() const { return getSize(); }
+    size_type capacity() const { return m_capacity; }
+    bool is_inline() const { return m_pArray == inlineStorage(); }
+
+private:
+    template<typename... Args>
+    T *emplace(const T *where, Args&&... args)
+    {
+        auto insertionIndex{static_cast<size_type>(where - startPtr())};
+        auto & size{getSize()};
+        if (unlikely(insertionIndex > size))
+        {
+            return endPtr();
+        }
+
+        if (unlikely(size == m_capacity))
+        {
+            growStorage(m_capacity * 2);
+        }
+
+        detail::openGap(getAlloc(), startPtr(), size, insertionIndex, 1);
+        T *raw_p = startPtr() + insertionIndex;
+        alloc_traits::construct(getAlloc(), raw_p, std::forward<Args>(args)...);
+        ++size;
+        return raw_p;
+    }
+
+    void growStorage(size_type storageCapacity)
+    {
+        auto & alloc = getAlloc();
+        T *p_newStorage = alloc_traits::allocate(alloc, storageCapacity);
+        detail::relocate(alloc, startPtr(), p_newStorage, getSize());
+        releaseStorage();
+        m_pArray = p_newStorage;
+        m_capacity = storageCapacity;
+    }
+
+    // expects the elements to be destroyed or relocated already
+    void releaseStorage()
+    {
+        if (!is_inline())
+        {
+            alloc_traits::deallocate(getAlloc(), m_pArray, m_capacity);
+            m_pArray = inlineStorage();
+            m_capacity = N;
+        }
+    }
+
+    // expects an empty vector owning only its inline buffer
+    void takeElements(small_vector & other)
+    {
+        if (other.is_inline())
+        {
+            detail::relocate(getAlloc(), other.startPtr(), startPtr(), other.size());
+        }
+        else
+        {
+            m_pArray = std::exchange(other.m_pArray, other.inlineStorage());
+            m_capacity = std::exchange(other.m_capacity, N);
+        }
+        getSize() = std::exchange(other.getSize(), 0);
+    }
+
+    T *inlineStorage() { return reinterpret_cast<T*>(m_storage); }
+    const T *inlineStorage() const { return reinterpret_cast<const T*>(m_storage); }
+
+    T *startPtr() { return m_pArray; }
+    const T *startPtr() const { return m_pArray; }
+    T *endPtr() { return m_pArray + getSize(); }
+    const T *endPtr() const { return m_pArray + getSize(); }
+
+    size_type & getSize() { return m_compressedPair.member(); }
+    const size_type & getSize() const { return m_compressedPair.member(); }
+    Allocator & getAlloc() { return m_compressedPair.base(); }
+    const Allocator & getAlloc() const { return m_compressedPair.base(); }
+
+private:
+    size_type m_capacity{N};
+    T *m_pArray{inlineStorage()};
+    ts::BaseMemberPair<Allocator, size_type> m_compressedPair{};
+    alignas(T) unsigned char m_storage[N * sizeof(T)];
+};
+
+}//ds
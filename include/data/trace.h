@@ -0,0 +1,119 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+
+namespace ds
+{
+
+/*
+ * Tracing policies for the containers taking a Trace parameter. A container
+ * records an event only inside if constexpr (Trace::enabled), so with
+ * null_trace, the default, tracing leaves no code behind.
+ * Events are structured: where and what are string literals, first and
+ * second carry numbers such as heights, indices or arithmetic values.
+ */
+struct trace_event
+{
+    const char *p_where;
+    const char *p_what;
+    std::int64_t first;
+    std::int64_t second;
+};
+
+// the arithmetic values a container traces, anything else is recorded as 0
+template<typename T>
+std::int64_t trace_value([[maybe_unused]] const T & value)
+{
+    if constexpr (std::is_arithmetic_v<T>)
+    {
+        return static_cast<std::int64_t>(value);
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+inline std::ostream & operator<<(std::ostream & out, const trace_event & event)
+{
+    return out << event.p_where << ": " << event.p_what << " " << event.first << " " << event.second;
+}
+
+struct null_trace
+{
+    static constexpr bool enabled{false};
+
+    static void record(const trace_event &) {}
+};
+
+// writes every event to stdout as it happens: for small inputs under a debugger only
+struct stdout_trace
+{
+    static constexpr bool enabled{true};
+
+    static void record(const trace_event & event)
+    {
+        std::cout << event << "\n";
+    }
+};
+
+/*
+ * Keeps the last Capacity events of each thread in memory and performs no
+ * I/O, so it can stay enabled in a production build and be dumped when
+ * something goes wrong. Every container traced with the same Capacity
+ * shares the calling thread's ring; the reading functions see that ring only.
+ */
+template<std::size_t Capacity = 1024>
+class ring_buffer_trace
+{
+    static_assert(Capacity > 0 && 0 == (Capacity & (Capacity - 1)), "ring_buffer_trace error: capacity must be a power of two");
+
+    struct ring
+    {
+        trace_event events[Capacity];
+        std::size_t recorded{0};
+    };
+
+public:
+    static constexpr bool enabled{true};
+    static constexpr std::size_t capacity{Capacity};
+
+    static void record(const trace_event & event)
+    {
+        auto & r{local()};
+        r.events[r.recorded++ & (Capacity - 1)] = event;
+    }
+
+    // events recorded by the calling thread since the last clear, overwritten ones included
+    static std::size_t recorded() { return local().recorded; }
+
+    // visits the retained events of the calling thread, oldest first
+    template<typename F>
+    static void for_each(F f)
+    {
+        const auto & r{local()};
+        auto first{r.recorded > Capacity ? r.recorded - Capacity : 0};
+        for (auto i = first; i < r.recorded; ++i)
+        {
+            f(r.events[i & (Capacity - 1)]);
+        }
+    }
+
+    static void dump(std::ostream & out)
+    {
+        for_each([&out](const trace_event & event){ out << event << "\n"; });
+    }
+
+    static void clear() { local().recorded = 0; }
+
+private:
+    static ring & local()
+    {
+        thread_local ring t_ring;
+        return t_ring;
+    }
+};
+
+}//ds
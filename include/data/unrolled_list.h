@@ -0,0 +1,470 @@
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "iterator_facade.h"
+#include "traits.h"
+
+namespace ds
+{
+
+namespace detail
+{
+
+// elements filling a chunk of about two cache lines, never fewer than eight
+template<typename T>
+constexpr std::size_t unrolled_chunk_capacity{std::max<std::size_t>(8, (128 - 3 * sizeof(void*)) / sizeof(T))};
+
+}//detail
+
+/*
+ * Doubly linked list of chunks, each holding up to ChunkCapacity elements
+ * side by side plus a count. A traversal follows one pointer per chunk
+ * instead of one per element, and the per node overhead of two links and a
+ * count is shared by the whole chunk.
+ * Inserting into a full chunk splits it in two halves; after a removal, two
+ * neighbouring chunks which fit together in half a chunk are merged. Insertions and removals invalidate only the
+ * iterators into the chunks they touch: the chunk itself, and the new or
+ * absorbed neighbour. Iterators into every other chunk stay valid.
+ */
+template<typename T,
+         std::size_t ChunkCapacity = detail::unrolled_chunk_capacity<T>,
+         typename Allocator = std::allocator<T>>
+class unrolled_list
+{
+    static_assert(!ts::is_reference_v<T>, "unrolled_list error: type reference not allowed");
+    static_assert(ChunkCapacity > 1, "unrolled_list error: chunks must hold at least two elements");
+
+    struct chunk_base
+    {
+        chunk_base *p_prev;
+        chunk_base *p_next;
+    };
+
+    struct chunk : chunk_base
+    {
+        T *at(std::size_t index) { return std::launder(reinterpret_cast<T*>(storage) + index); }
+
+        std::size_t count{0};
+        alignas(T) unsigned char storage[sizeof(T) * ChunkCapacity];
+    };
+
+    using chunk_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<chunk>;
+    using chunk_alloc_traits = std::allocator_traits<chunk_allocator>;
+
+    template<bool Const>
+    class node_iterator : public iterator_facade<node_iterator<Const>,
+                                                 std::conditional_t<Const, const T, T>,
+                                                 std::bidirectional_iterator_tag>
+    {
+        friend unrolled_list;
+        friend iterator_facade<node_iterator<Const>,
+                               std::conditional_t<Const, const T, T>,
+                               std::bidirectional_iterator_tag>;
+
+    public:
+        node_iterator() = default;
+
+        template<bool C, typename = std::enable_if_t<Const && !C>>
+        node_iterator(const node_iterator<C> & other) :
+            p_node{other.p_node},
+            index{other.index}
+        {}
+
+    protected:
+        node_iterator(chunk_base *p, std::size_t i) :
+            p_node{p},
+            index{i}
+        {}
+
+        template<bool C>
+        bool equals(const node_iterator<C> & other) const
+        {
+            return p_node == other.p_node && index == other.index;
+        }
+
+        auto & dereference() const
+        {
+            return *static_cast<chunk*>(p_node)->at(index);
+        }
+
+        void increment()
+        {
+            if (++index == static_cast<chunk*>(p_node)->count)
+            {
+                p_node = p_node->p_next;
+                index = 0;
+            }
+        }
+
+        void decrement()
+        {
+            if (0 == index)
+            {
+                p_node = p_node->p_prev;
+                index = static_cast<chunk*>(p_node)->count;
+            }
+            --index;
+        }
+
+    private:
+        chunk_base *p_node{nullptr};
+        std::size_t index{0};
+    };
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = node_iterator<false>;
+    using const_iterator = node_iterator<true>;
+
+    static constexpr size_type chunk_capacity{ChunkCapacity};
+
+public:
+    unrolled_list(const allocator_type & alloc = {}) :
+        m_alloc{alloc}
+    {}
+
+    unrolled_list(std::initializer_list<value_type> ilist, const allocator_type & alloc = {}) :
+        m_alloc{alloc}
+    {
+        insert(end(), ilist.begin(), ilist.end());
+    }
+
+    unrolled_list(const unrolled_list & other) :
+        m_alloc{chunk_alloc_traits::select_on_container_copy_construction(other.m_alloc)}
+    {
+        insert(end(), other.begin(), other.end());
+    }
+
+    unrolled_list(unrolled_list && other) :
+        m_alloc{other.m_alloc}
+    {
+        adopt(other);
+    }
+
+    ~unrolled_list() { clear(); }
+
+    unrolled_list & operator=(const unrolled_list & other)
+    {
+        if (this != &other)
+        {
+            clear();
+            insert(end(), other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    unrolled_list & operator=(unrolled_list && other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        clear();
+        constexpr bool pocma{chunk_alloc_traits::propagate_on_container_move_assignment::value};
+        if constexpr (pocma)
+        {
+            m_alloc = other.m_alloc;
+            adopt(other);
+        }
+        else if (m_alloc == other.m_alloc)
+        {
+            adopt(other);
+        }
+        else
+        {
+            insert(end(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            other.clear();
+        }
+        return *this;
+    }
+
+    void swap(unrolled_list & other)
+    {
+        auto temp{std::move(*this)};
+        *this = std::move(other);
+        other = std::move(temp);
+    }
+
+public:
+    iterator begin() noexcept { return iterator(m_header.p_next, 0); }
+    const_iterator begin() const noexcept { return const_iterator(m_header.p_next, 0); }
+
+    iterator end() noexcept { return iterator(&m_header, 0); }
+    const_iterator end() const noexcept { return const_iterator(const_cast<chunk_base*>(&m_header), 0); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    size_type size() const { return m_size; }
+    bool empty() const { return 0 == m_size; }
+
+    reference front() { return *begin(); }
+    const_reference front() const { return *begin(); }
+
+    reference back() { return *std::prev(end()); }
+    const_reference back() const { return *std::prev(end()); }
+
+    template<typename U>
+    void push_back(U && value)
+    {
+        emplaceAt(&m_header, 0, std::forward<U>(value));
+    }
+
+    template<typename U>
+    void push_front(U && value)
+    {
+        emplaceAt(m_header.p_next, 0, std::forward<U>(value));
+    }
+
+    void pop_back()
+    {
+        if (!empty())
+        {
+            erase(std::prev(end()));
+        }
+    }
+
+    void pop_front()
+    {
+        if (!empty())
+        {
+            erase(begin());
+        }
+    }
+
+    template<bool C>
+    iterator insert(node_iterator<C> pos, const value_type & value)
+    {
+        return emplaceAt(pos.p_node, pos.index, value);
+    }
+
+    template<bool C>
+    iterator insert(node_iterator<C> pos, value_type && value)
+    {
+        return emplaceAt(pos.p_node, pos.index, std::move(value));
+    }
+
+    // returns an iterator to the first inserted element, or pos when the range is empty
+    template<bool C, typename InputIt>
+    iterator insert(node_iterator<C> pos, InputIt first, InputIt last)
+    {
+        if (first == last)
+        {
+            return iterator(pos.p_node, pos.index);
+        }
+
+        iterator next(pos.p_node, pos.index);
+        difference_type count{0};
+        for (; first != last; ++first, ++count)
+        {
+            next = std::next(emplaceAt(next.p_node, next.index, *first));
+        }
+        // a split may have moved the first inserted element: walk back from the last one
+        return std::prev(next, count);
+    }
+
+    template<bool C>
+    iterator erase(node_iterator<C> pos)
+    {
+        return eraseAt(static_cast<chunk*>(pos.p_node), pos.index);
+    }
+
+    void clear()
+    {
+        auto *p_node{m_header.p_next};
+        while (&m_header != p_node)
+        {
+            auto *p_next{p_node->p_next};
+            destroyChunk(static_cast<chunk*>(p_node));
+            p_node = p_next;
+        }
+        m_header.p_prev = m_header.p_next = &m_header;
+        m_size = 0;
+    }
+
+    // number of chunks in use
+    size_type chunk_count() const
+    {
+        size_type count{0};
+        for (auto *p_node = m_header.p_next; &m_header != p_node; p_node = p_node->p_next)
+        {
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    // inserts before element index of p_node; the header stands for the end
+    template<typename... Args>
+    iterator emplaceAt(chunk_base *p_node, size_type index, Args&&... args)
+    {
+        chunk *p_chunk{nullptr};
+        if (&m_header == p_node)
+        {
+            // appending fills the last chunk before starting a new one
+            auto *p_last{m_header.p_prev};
+            if (&m_header == p_last || ChunkCapacity == static_cast<chunk*>(p_last)->count)
+            {
+                p_last = createChunk(p_last);
+            }
+            p_chunk = static_cast<chunk*>(p_last);
+            index = p_chunk->count;
+        }
+        else
+        {
+            p_chunk = static_cast<chunk*>(p_node);
+            if (ChunkCapacity == p_chunk->count)
+            {
+                auto *p_upper{split(p_chunk)};
+                if (index > p_chunk->count)
+                {
+                    index -= p_chunk->count;
+                    p_chunk = p_upper;
+                }
+            }
+        }
+
+        auto & count{p_chunk->count};
+        if (index == count)
+        {
+            ::new(p_chunk->at(index)) T(std::forward<Args>(args)...);
+        }
+        else
+        {
+            T value(std::forward<Args>(args)...);
+            ::new(p_chunk->at(count)) T(std::move(*p_chunk->at(count - 1)));
+            std::move_backward(p_chunk->at(index), p_chunk->at(count - 1), p_chunk->at(count));
+            *p_chunk->at(index) = std::move(value);
+        }
+        ++count;
+        ++m_size;
+        return iterator(p_chunk, index);
+    }
+
+    iterator eraseAt(chunk *p_chunk, size_type index)
+    {
+        auto & count{p_chunk->count};
+        std::move(p_chunk->at(index + 1), p_chunk->at(count), p_chunk->at(index));
+        p_chunk->at(--count)->~T();
+        --m_size;
+
+        auto *p_next{p_chunk->p_next};
+        if (0 == count)
+        {
+            unlink(p_chunk);
+            destroyChunk(p_chunk);
+            return iterator(p_next, 0);
+        }
+
+        auto *p_prev{p_chunk->p_prev};
+        if (fitInHalf(p_chunk, p_next))
+        {
+            absorbNext(p_chunk);
+        }
+        else if (fitInHalf(p_prev, p_chunk))
+        {
+            index += static_cast<chunk*>(p_prev)->count;
+            p_chunk = static_cast<chunk*>(p_prev);
+            absorbNext(p_chunk);
+        }
+        return index == p_chunk->count ? iterator(p_chunk->p_next, 0) : iterator(p_chunk, index);
+    }
+
+    // moves the upper half of a full chunk to a new chunk right after it
+    chunk *split(chunk *p_chunk)
+    {
+        auto *p_upper{createChunk(p_chunk)};
+        auto half{p_chunk->count / 2};
+        relocate(p_chunk, half, p_chunk->count, p_upper);
+        return p_upper;
+    }
+
+    bool fitInHalf(chunk_base *p_first, chunk_base *p_second) const
+    {
+        return &m_header != p_first && &m_header != p_second &&
+               static_cast<chunk*>(p_first)->count + static_cast<chunk*>(p_second)->count <= ChunkCapacity / 2;
+    }
+
+    void absorbNext(chunk *p_chunk)
+    {
+        auto *p_next{static_cast<chunk*>(p_chunk->p_next)};
+        relocate(p_next, 0, p_next->count, p_chunk);
+        unlink(p_next);
+        destroyChunk(p_next);
+    }
+
+    // moves elements [first, last) of p_from to the end of p_to
+    static void relocate(chunk *p_from, size_type first, size_type last, chunk *p_to)
+    {
+        if constexpr (ts::is_trivially_relocatable_v<T>)
+        {
+            std::memcpy(static_cast<void*>(p_to->at(p_to->count)), p_from->at(first), (last - first) * sizeof(T));
+        }
+        else
+        {
+            std::uninitialized_move(p_from->at(first), p_from->at(last), p_to->at(p_to->count));
+            std::destroy(p_from->at(first), p_from->at(last));
+        }
+        p_to->count += last - first;
+        p_from->count -= last - first;
+    }
+
+    chunk *createChunk(chunk_base *p_after)
+    {
+        auto *p_chunk{chunk_alloc_traits::allocate(m_alloc, 1)};
+        ::new(static_cast<void*>(p_chunk)) chunk{};
+        p_chunk->p_prev = p_after;
+        p_chunk->p_next = p_after->p_next;
+        p_after->p_next->p_prev = p_chunk;
+        p_after->p_next = p_chunk;
+        return p_chunk;
+    }
+
+    void destroyChunk(chunk *p_chunk)
+    {
+        std::destroy(p_chunk->at(0), p_chunk->at(p_chunk->count));
+        p_chunk->~chunk();
+        chunk_alloc_traits::deallocate(m_alloc, p_chunk, 1);
+    }
+
+    static void unlink(chunk_base *p_node)
+    {
+        p_node->p_prev->p_next = p_node->p_next;
+        p_node->p_next->p_prev = p_node->p_prev;
+    }
+
+    // takes over the chunks of other, expects this list empty
+    void adopt(unrolled_list & other)
+    {
+        if (other.empty())
+        {
+            return;
+        }
+
+        m_header = other.m_header;
+        m_header.p_next->p_prev = &m_header;
+        m_header.p_prev->p_next = &m_header;
+        m_size = std::exchange(other.m_size, 0);
+        other.m_header.p_prev = other.m_header.p_next = &other.m_header;
+    }
+
+private:
+    chunk_base m_header{&m_header, &m_header};
+    size_type m_size{0};
+    chunk_allocator m_alloc;
+};
+
+}//ds
@@ -1,4 +1,7 @@
 #pragma once
+#include <algorithm>
+#include <cstring>
+#include <memory>
 #include <stdexcept>
 #include <utility>
 
@@ -9,6 +12,84 @@
 
 namespace ds
 {
+namespace detail
+{
+
+// shifts the tail [startGapIdx, size) right by gapLength;
+// on return the gap holds raw storage, ready to be constructed into
+template<typename Alloc, typename T>
+void openGap(Alloc & alloc, T *p, std::size_t size, std::size_t startGapIdx, std::size_t gapLength)
+{
+    using alloc_traits = std::allocator_traits<Alloc>;
+    if (0 == gapLength || startGapIdx >= size)
+    {
+        return;
+    }
+
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        std::memmove(p + startGapIdx + gapLength, p + startGapIdx, (size - startGapIdx) * sizeof(T));
+    }
+    else
+    {
+        // the last elements of the tail land past the current end, in raw storage
+        std::size_t splitIdx{std::max(startGapIdx, size - std::min(gapLength, size))};
+        for (std::size_t i = size; i-- > splitIdx;)
+        {
+            alloc_traits::construct(alloc, p + i + gapLength, std::move(p[i]));
+        }
+        std::move_backward(p + startGapIdx, p + splitIdx, p + splitIdx + gapLength);
+
+        for (std::size_t i = startGapIdx; i < std::min(startGapIdx + gapLength, size); ++i)
+        {
+            alloc_traits::destroy(alloc, p + i);
+        }
+    }
+}
+
+// drops the elements [startGapIdx, startGapIdx + gapLength) and shifts the tail left
+template<typename Alloc, typename T>
+void closeGap(Alloc & alloc, T *p, std::size_t size, std::size_t startGapIdx, std::size_t gapLength)
+{
+    using alloc_traits = std::allocator_traits<Alloc>;
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        std::memmove(p + startGapIdx, p + startGapIdx + gapLength,
+                     (size - startGapIdx - gapLength) * sizeof(T));
+    }
+    else
+    {
+        std::move(p + startGapIdx + gapLength, p + size, p + startGapIdx);
+        for (std::size_t i = size - gapLength; i < size; ++i)
+        {
+            alloc_traits::destroy(alloc, p + i);
+        }
+    }
+}
+
+// moves count elements from src into the raw storage at dest and ends their lifetime in src
+template<typename Alloc, typename T>
+void relocate(Alloc & alloc, T *src, T *dest, std::size_t count)
+{
+    using alloc_traits = std::allocator_traits<Alloc>;
+    if constexpr (ts::is_trivially_relocatable_v<T>)
+    {
+        if (0 != count)
+        {
+            std::memcpy(dest, src, count * sizeof(T));
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            alloc_traits::construct(alloc, dest + i, std::move_if_noexcept(src[i]));
+            alloc_traits::destroy(alloc, src + i);
+        }
+    }
+}
+
+}//detail
 
 template<typename T,
          typename Allocator = std::allocator<T>>
@@ -36,13 +117,13 @@ public:
 private:
     template<bool Const>
     class internal_iterator : public iterator_facade<internal_iterator<Const>,
-                                                     std::conditional_t<Const, T, const T>,
+                                                     std::conditional_t<Const, const T, T>,
                                                      std::bidirectional_iterator_tag>
     {
 
-        using base = iterator_facade<internal_iterator<Const>, std::conditional_t<Const, T, const T>, std::bidirectional_iterator_tag>;
+        using base = iterator_facade<internal_iterator<Const>, std::conditional_t<Const, const T, T>, std::bidirectional_iterator_tag>;
 
-        friend iterator_facade<internal_iterator<Const>, std::conditional_t<Const, T, const T>, std::bidirectional_iterator_tag>;
+        friend iterator_facade<internal_iterator<Const>, std::conditional_t<Const, const T, T>, std::bidirectional_iterator_tag>;
         friend vector;
 
     public:
@@ -102,6 +183,8 @@ public:
         m_compressedPair(alloc, 0)
     {}
 
+    ~vector() { clear(); }
+
     vector(const vector & other) :
         m_compressedPair(other.getAlloc(), 0)
     {
@@ -271,8 +354,10 @@ public:
 
     void clear()
     {
-        clear(m_pArray, m_capacity);
+        clear(m_pArray, getSize(), m_capacity);
         getSize() = 0;
+        m_pArray = nullptr;
+        m_capacity = 0;
     }
 
     void reserve(size_type capacity)
@@ -502,6 +587,25 @@ private:
         return true;
     }
 
+    // the bytes of a trivially relocatable element are the element itself:
+    // the old storage is copied in at most two bulk moves around the gap
+    // and then released without running any destructor
+    void relocateFrom(pointer p_old, pointer p_new, size_type size,
+                      size_type startGapIdx = 0, size_type gapLength = 0)
+    {
+        if (unlikely(nullptr == p_old || 0 == size))
+        {
+            return;
+        }
+
+        auto prefixLength{std::min(startGapIdx, size)};
+        T *raw_src = static_cast<T*>(std::addressof(p_old[0]));
+        T *raw_dest = static_cast<T*>(std::addressof(p_new[0]));
+        std::memcpy(raw_dest, raw_src, prefixLength * sizeof(T));
+        std::memcpy(raw_dest + prefixLength + gapLength, raw_src + prefixLength,
+                    (size - prefixLength) * sizeof(T));
+    }
+
     template<typename InputIt>
     pointer assignFrom(pointer p_where, InputIt first, InputIt last)
     {
@@ -532,23 +636,16 @@ private:
     //        |<----->| gap size
     //1 3 4 5 0 0 0 0 8 5 7 9 3 4 0
     //1 3 4 5 8 5 7 9 3 0 0 0 0 4 0
-    bool makeGapInCurrentStorage(size_type startGapIdx, difference_type gapLength)
+    bool makeGapInCurrentStorage(size_type startGapIdx, size_type gapLength)
     {
         auto size = getSize();
-        if (unlikely(size + gapLength > m_capacity))
+        if (unlikely(size + gapLength > m_capacity || startGapIdx > size))
         {
             return false;
         }
 
-        auto & alloc = getAlloc();
-        auto end{startGapIdx > 0 ? startGapIdx : 1};
-        for (size_type i = size - 1; i >= end; --i)
-        {
-              T *raw_p = std::addressof(m_pArray[i+gapLength]);
-              alloc_traits::construct(alloc, raw_p, m_pArray[i]);
-              raw_p = std::addressof(m_pArray[i]);
-              alloc_traits::destroy(alloc, raw_p);
-        }
+        T *raw_p = static_cast<T*>(std::addressof(m_pArray[0]));
+        detail::openGap(getAlloc(), raw_p, size, startGapIdx, gapLength);
         return true;
     }
 
@@ -558,19 +655,16 @@ private:
     //1 9 2 4 5 2 35 7 33 21 26 31 43 12 5 7 0 0 0 0 0 0 0 92 61 87 0 0 0 0 
     //1 9 2 4 5 2 35 7 33 21 26 31 43 12 5 7 92 0 0 0 0 0 0 0 61 87 0 0 0 0 
     //1 9 2 4 5 2 35 7 33 21 26 31 43 12 5 7 92 61 87 0 0 0 0 0 0 0 0 0 0 0
-    bool closeGapInCurrentStorage(size_type startGapIdx, difference_type gapLength)
+    bool closeGapInCurrentStorage(size_type startGapIdx, size_type gapLength)
     {
         auto size = getSize();
-        if(unlikely(startGapIdx + gapLength > size - gapLength))
+        if(unlikely(startGapIdx + gapLength > size))
         {
             return false;
         }
 
-        using std::swap;
-        for (size_type i = startGapIdx; i < size - 1; ++i)
-        {
-            swap(m_pArray[i], m_pArray[i+gapLength]);
-        }
+        T *raw_p = static_cast<T*>(std::addressof(m_pArray[0]));
+        detail::closeGap(getAlloc(), raw_p, size, startGapIdx, gapLength);
         return true;
     }
     
@@ -581,12 +675,34 @@ private:
             return false;
         }
 
+        if constexpr (ts::is_trivially_relocatable_v<value_type> && ts::has_reallocate_v<allocator_type>)
+        {
+            // the allocator extends the block in place when it can: old and new
+            // buffers are never alive together and only the tail after the gap moves
+            m_pArray = getAlloc().reallocate(m_pArray, m_capacity, storageCapacity);
+            m_capacity = storageCapacity;
+
+            auto size{getSize()};
+            if (0 != gapLength && static_cast<size_type>(startGapIdx) < size)
+            {
+                T *raw_p = static_cast<T*>(std::addressof(m_pArray[startGapIdx]));
+                std::memmove(raw_p + gapLength, raw_p, (size - startGapIdx) * sizeof(T));
+            }
+            return true;
+        }
+
         auto p_newStorage = allocate(storageCapacity);
-        if (constructFrom(m_pArray, p_newStorage, getSize(), storageCapacity, startGapIdx, gapLength))
+        if constexpr (ts::is_trivially_relocatable_v<value_type>)
         {
-            auto currentSize{getSize()};
-            clear();
-            getSize() = currentSize;
+            relocateFrom(m_pArray, p_newStorage, getSize(), startGapIdx, gapLength);
+            alloc_traits::deallocate(getAlloc(), m_pArray, m_capacity);
+            m_pArray = p_newStorage;
+            m_capacity = storageCapacity;
+            return true;
+        }
+        else if (constructFrom(m_pArray, p_newStorage, getSize(), storageCapacity, startGapIdx, gapLength))
+        {
+            clear(m_pArray, getSize(), m_capacity);
             m_pArray = p_newStorage;
             m_capacity = storageCapacity;
             return true;
@@ -595,7 +711,7 @@ private:
         return false;
     }
 
-    void clear(pointer p, size_type count)
+    void clear(pointer p, size_type size, size_type capacity)
     {
         if (unlikely(nullptr == p))
         {
@@ -603,20 +719,22 @@ private:
         }
 
         auto & alloc = getAlloc();
-        for (size_type i = 0; i < count; ++i)
+        if constexpr (!std::is_trivially_destructible_v<value_type>)
         {
-            T *raw_p = static_cast<T*>(std::addressof(p[count]));
-            alloc_traits::destroy(alloc, raw_p);
+            for (size_type i = 0; i < size; ++i)
+            {
+                T *raw_p = static_cast<T*>(std::addressof(p[i]));
+                alloc_traits::destroy(alloc, raw_p);
+            }
         }
 
-        alloc_traits::deallocate(alloc, p, count);
-        p = nullptr;
+        alloc_traits::deallocate(alloc, p, capacity);
     }
 
     bool preparePositionalInsert(difference_type insertionIndex, size_type inputSize)
     {
         auto size = getSize();
-        if (inputSize < m_capacity - size && 0 != size)
+        if (size + inputSize <= m_capacity)
         {
             return makeGapInCurrentStorage(insertionIndex, inputSize);
         }
@@ -627,9 +745,9 @@ private:
     bool prepareStorageCapacity(size_type inputSize = 0, difference_type insertionIndex = 0) 
     {
         auto size{getSize()};
-        if (size >= m_capacity)
+        if (size + std::max<size_type>(inputSize, 1) > m_capacity)
         {
-            auto storageCapacity{m_capacity > inputSize ? m_capacity*2 : ts::nextLargerPowerOf2(inputSize + size + 1)};
+            auto storageCapacity{std::max(m_capacity*2, ts::nextLargerPowerOf2(inputSize + size + 1))};
             if (likely(0 != m_capacity))
             {
                 return increaseStorage(storageCapacity, insertionIndex, inputSize);
@@ -659,9 +777,10 @@ private:
     {
         auto & size{getSize()};
         auto sizeNeeded{newSize - size};
-        if (prepareStorageCapacity(sizeNeeded))
+        if (prepareStorageCapacity(sizeNeeded, size))
         {
-            construct(m_pArray[size], sizeNeeded);
+            construct(m_pArray + size, sizeNeeded);
+            size = newSize;
         }
     }
 
@@ -689,7 +808,7 @@ private:
 
     pointer erase(pointer first, pointer last)
     {
-        if (!(validate() && validate(last))){
+        if (!(validate(first) && first <= last && last <= endPtr())){
             return endPtr();
         }
 
@@ -723,7 +842,7 @@ private:
     template<typename U>
     pointer insert(pointer where, U && value)
     {
-        if (checkForNullStorage(where); !validate(where))
+        if (checkForNullStorage(where); !(validate(where) || endPtr() == where))
         {
             return endPtr();
         }
@@ -746,7 +865,7 @@ private:
     {
         auto inputSize{std::distance(first, last)};
         auto & size{getSize()};
-        if (checkForNullStorage(where, inputSize); !validate(where))
+        if (checkForNullStorage(where, inputSize); !(validate(where) || endPtr() == where))
         {
             return endPtr();
         }
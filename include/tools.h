@@ -5,6 +5,20 @@
 #define likely(EXPR) __builtin_expect((bool)(EXPR), true)
 #define unlikely(EXPR) __builtin_expect((bool)(EXPR), false)
 
+/*
+ * With DS_LIST_CHECKED the lists validate positions before they link or
+ * unlink: ds::list nodes record the list owning them and ds::intrusive_list
+ * refuses hooks already in, or not in, a list. It is on unless NDEBUG is
+ * defined; unchecked ds::list nodes hold the value and the two links only.
+ */
+#if !defined(DS_LIST_CHECKED)
+#if defined(NDEBUG)
+#define DS_LIST_CHECKED 0
+#else
+#define DS_LIST_CHECKED 1
+#endif
+#endif
+
 namespace ts
 {
 
@@ -87,6 +101,17 @@ inline std::size_t nextPrime(std::size_t val)
     return val;
 }
 
+/*
+ * Fibonacci hashing followed by a fold of the high half onto the low half:
+ * spreads the entropy of weak hashes (e.g. the identity hash of integers)
+ * over every bit, so that masking or multiply-shift reductions can use them
+ */
+inline std::size_t mixHash(std::size_t hash)
+{
+    hash *= 0x9E3779B97F4A7C15ull;
+    return hash ^ (hash >> 32);
+}
+
 template<typename T>
 bool belongsToRange(T *p, T *regionStart, std::size_t regionSize)
 {
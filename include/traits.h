@@ -1,4 +1,6 @@
 #pragma once
+#include <memory>
+#include <type_traits>
 
 
 namespace ts
@@ -15,5 +17,49 @@ struct is_reference<T&> : std::true_type
 template<typename T>
 constexpr bool is_reference_v{is_reference<T>::value};
 
-}//ts
+/*
+ * A type is trivially relocatable when moving an object to a new address and
+ * ending the lifetime of the source is equivalent to copying its bytes.
+ * Trivially copyable types always qualify; other types may opt in by
+ * specializing this trait.
+ */
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T>
+{};
+
+template<typename T>
+constexpr bool is_trivially_relocatable_v{is_trivially_relocatable<T>::value};
+
+/*
+ * Detects allocators able to resize a block in place:
+ * pointer reallocate(pointer p, size_t oldCount, size_t newCount)
+ */
+template<typename Alloc, typename = void>
+struct has_reallocate : std::false_type
+{};
+
+template<typename Alloc>
+struct has_reallocate<Alloc, std::void_t<decltype(std::declval<Alloc&>().reallocate(
+                                 std::declval<typename std::allocator_traits<Alloc>::pointer>(),
+                                 std::size_t{}, std::size_t{}))>> : std::true_type
+{};
 
+template<typename Alloc>
+constexpr bool has_reallocate_v{has_reallocate<Alloc>::value};
+
+/*
+ * Detects hashers and comparators declaring is_transparent, which accept any
+ * type comparable with the key and let lookups skip building a key
+ */
+template<typename T, typename = void>
+struct is_transparent : std::false_type
+{};
+
+template<typename T>
+struct is_transparent<T, std::void_t<typename T::is_transparent>> : std::true_type
+{};
+
+template<typename T>
+constexpr bool is_transparent_v{is_transparent<T>::value};
+
+}//ts
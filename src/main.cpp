@@ -1,13 +1,18 @@
 #include <iostream>
 #include <string_view>
 #include <random>
+#include <chrono>
 #include <cassert>
 
+#include <sys/resource.h>
+
 //#include "collection_tools.hxx"
 #include "avl_tree.h"
 #include "list.h"
 #include "vector.h"
 #include "vector_v1.h"
+#include "remap_allocator.h"
+#include "pool_allocator.h"
 #include "hash_table.h"
 #include "search.h"
 #include "tools.h"
@@ -38,6 +43,7 @@ void printStats(const ds::vector<T> & v, std::string_view name)
     std::cout << name << " capacity: " << v.capacity() << "\n";
 }
 
+template<typename Allocator>
 void testListIteration()
 {
     constexpr auto maxSize{L1_SIZE};
@@ -45,7 +51,7 @@ void testListIteration()
 //    auto maxIterations{100};
     std::default_random_engine generator;
     std::uniform_int_distribution<int> distribution{0, maxSize-1};
-    ds::list<uint8_t> l1;
+    ds::list<uint8_t, Allocator> l1;
 
     auto arr = ts::generate_fix_sized_array<uint8_t, maxSize>();
     l1.insert(l1.begin(), arr.begin(), arr.end());
@@ -112,6 +118,42 @@ void profileVectorPushBack()
     }
 }
 
+// peak RSS is reported for the whole process: run a single variant per execution
+template<typename Allocator>
+void profileVectorGrowth(std::string_view name)
+{
+    using clock = std::chrono::steady_clock;
+    constexpr std::size_t maxIterations{128*1024*1024};
+
+    ds::vector<uint64_t, Allocator> v1;
+    std::size_t growths{0};
+    clock::duration growthTime{0};
+
+    for (std::size_t i = 0; i < maxIterations; ++i)
+    {
+        if (v1.size() == v1.capacity())
+        {
+            auto start{clock::now()};
+            v1.push_back(i);
+            growthTime += clock::now() - start;
+            ++growths;
+        }
+        else
+        {
+            v1.push_back(i);
+        }
+    }
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    auto growthUs{std::chrono::duration_cast<std::chrono::microseconds>(growthTime).count()};
+
+    std::cout << name << " elements: " << v1.size() << "; capacity: " << v1.capacity() << "\n";
+    std::cout << name << " growths: " << growths << "; total growth time: " << growthUs << " us"
+              << "; time per growth: " << growthUs / std::max<std::size_t>(growths, 1) << " us\n";
+    std::cout << name << " peak RSS: " << usage.ru_maxrss / 1024 << " MiB\n";
+}
+
 void testRowMajorTraversal()
 {
     auto maxIterations{100};
@@ -352,5 +394,9 @@ int main()
 //    profileVectorFrontPositionInsert();
 //    profileVectorRandomPositionInsert();
 //    profileVectorPushBack();
+//    profileVectorGrowth<std::allocator<uint64_t>>("std::allocator");
+//    profileVectorGrowth<ds::remap_allocator<uint64_t>>("ds::remap_allocator");
+//    testListIteration<std::allocator<uint8_t>>();
+//    testListIteration<ds::pool_allocator<uint8_t>>();
     return 0;
 }
@@ -0,0 +1,266 @@
+#pragma once
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "avl_tree.h"
+
+namespace test
+{
+namespace ds_avl_tree
+{
+
+TEST(AvlTreeTests, TestNodeHoldsLinksValueAndHeightOnly)
+{
+    // three links, an int and a byte of height, rounded up to the pointer alignment
+    EXPECT_EQ(sizeof(avl_tree<int>::node), 4 * sizeof(void*));
+}
+
+template<typename Tree>
+void checkInsertFindRemove()
+{
+    std::vector<int> values(2000);
+    std::iota(std::begin(values), std::end(values), 0);
+    std::shuffle(std::begin(values), std::end(values), std::mt19937{7});
+
+    Tree tree;
+    for (auto value : values)
+    {
+        tree.insert(value);
+    }
+    tree.insert(values.front());
+    EXPECT_EQ(tree.size(), values.size());
+
+    for (int value = 0; value < 2000; value += 2)
+    {
+        tree.remove(value);
+    }
+    EXPECT_EQ(tree.size(), values.size() / 2);
+
+    std::vector<int> inOrder(std::begin(tree), std::end(tree));
+    EXPECT_EQ(inOrder.size(), values.size() / 2);
+    EXPECT_EQ(std::is_sorted(std::begin(inOrder), std::end(inOrder)), true);
+    EXPECT_EQ(tree.contains(1), true);
+    EXPECT_EQ(tree.contains(2), false);
+    EXPECT_EQ(*tree.find(1999), 1999);
+}
+
+TEST(AvlTreeTests, TestInsertFindRemove)
+{
+    checkInsertFindRemove<avl_tree<int>>();
+}
+
+TEST(AvlTreeTests, TestPoolAvlTreeInsertFindRemove)
+{
+    checkInsertFindRemove<pool_avl_tree<int>>();
+}
+
+// counts the comparisons made by every tree using it
+struct counting_less
+{
+    static inline std::size_t s_calls{0};
+
+    bool operator()(int lhs, int rhs) const
+    {
+        ++s_calls;
+        return lhs < rhs;
+    }
+};
+
+TEST(AvlTreeTests, TestIterationFollowsLinksOnly)
+{
+    avl_tree<int, counting_less> tree;
+    for (int value = 0; value < 1000; ++value)
+    {
+        tree.insert((value * 7919) % 1000);
+    }
+
+    counting_less::s_calls = 0;
+    int expected{0};
+    for (auto value : tree)
+    {
+        EXPECT_EQ(value, expected++);
+    }
+    EXPECT_EQ(expected, 1000);
+
+    for (auto it = tree.end(); it != tree.begin();)
+    {
+        EXPECT_EQ(*--it, --expected);
+    }
+    EXPECT_EQ(expected, 0);
+    EXPECT_EQ(counting_less::s_calls, 0);
+}
+
+TEST(AvlTreeTests, TestCopyIteratesLikeTheOriginal)
+{
+    avl_tree<int> tree;
+    for (int value : {50, 20, 80, 10, 30, 70, 90, 60})
+    {
+        tree.insert(value);
+    }
+
+    const avl_tree<int> copy{tree};
+    tree.remove(50);
+    EXPECT_EQ(std::vector<int>(std::begin(copy), std::end(copy)), (std::vector<int>{10, 20, 30, 50, 60, 70, 80, 90}));
+    EXPECT_EQ(*--copy.end(), 90);
+    avl_tree<int>::const_iterator it{tree.begin()};
+    EXPECT_EQ(*it, 10);
+}
+
+TEST(AvlTreeTests, TestSelfAssignmentKeepsTheTree)
+{
+    avl_tree<int> tree;
+    for (int value = 0; value < 50; ++value)
+    {
+        tree.insert(value);
+    }
+    std::vector<int> expected(50);
+    std::iota(expected.begin(), expected.end(), 0);
+
+    auto & alias{tree};
+    tree = alias;
+    EXPECT_EQ(tree.size(), 50);
+    EXPECT_EQ(std::vector<int>(std::begin(tree), std::end(tree)), expected);
+
+    tree = std::move(alias);
+    EXPECT_EQ(tree.size(), 50);
+    EXPECT_EQ(std::vector<int>(std::begin(tree), std::end(tree)), expected);
+}
+
+TEST(AvlTreeTests, TestPrintWritesTheValues)
+{
+    avl_tree<int> tree;
+    testing::internal::CaptureStdout();
+    tree.print();
+    tree.printReverse();
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "avl_tree::print()\n\navl_tree::print()\n\n\n");
+
+    for (int value : {2, 1, 3})
+    {
+        tree.insert(value);
+    }
+    testing::internal::CaptureStdout();
+    tree.print();
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "avl_tree::print()\n1 2 3 \n");
+
+    testing::internal::CaptureStdout();
+    tree.printReverse();
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "avl_tree::print()\n3 2 1 \navl_tree::print() root value: 2\n\n");
+}
+
+template<typename Tree>
+void checkMoveAssignmentMovesTheSize()
+{
+    Tree from;
+    Tree to;
+    for (int value = 0; value < 10; ++value)
+    {
+        from.insert(value);
+    }
+    to.insert(42);
+
+    to = std::move(from);
+    EXPECT_EQ(to.size(), 10);
+    EXPECT_EQ(to.empty(), false);
+    EXPECT_EQ(std::distance(std::begin(to), std::end(to)), 10);
+    EXPECT_EQ(from.size(), 0);
+    EXPECT_EQ(from.empty(), true);
+    EXPECT_EQ(std::begin(from), std::end(from));
+
+    to.swap(from);
+    EXPECT_EQ(from.size(), 10);
+    EXPECT_EQ(to.size(), 0);
+}
+
+TEST(AvlTreeTests, TestMoveAssignmentMovesTheSize)
+{
+    checkMoveAssignmentMovesTheSize<avl_tree<int>>();
+    checkMoveAssignmentMovesTheSize<pool_avl_tree<int>>();
+}
+
+TEST(AvlTreeTests, TestFromSortedBuildsWithoutComparing)
+{
+    std::vector<int> values(1000);
+    std::iota(std::begin(values), std::end(values), 0);
+
+    counting_less::s_calls = 0;
+    auto tree{avl_tree<int, counting_less>::from_sorted(std::begin(values), std::end(values))};
+    EXPECT_EQ(counting_less::s_calls, 0);
+    EXPECT_EQ(tree.size(), values.size());
+    EXPECT_EQ(std::vector<int>(std::begin(tree), std::end(tree)), values);
+    EXPECT_EQ(*--tree.end(), 999);
+
+    // heights must be right for later inserts and removes to keep the tree balanced
+    for (int value = 0; value < 1000; value += 3)
+    {
+        tree.remove(value);
+    }
+    tree.insert(-1);
+    tree.insert(1000);
+    EXPECT_EQ(tree.size(), 668);
+    EXPECT_EQ(tree.contains(-1), true);
+    EXPECT_EQ(tree.contains(3), false);
+    EXPECT_EQ(std::is_sorted(std::begin(tree), std::end(tree)), true);
+
+    std::vector<int> none;
+    EXPECT_EQ(avl_tree<int>::from_sorted(std::begin(none), std::end(none)).empty(), true);
+}
+
+TEST(AvlTreeTests, TestFromSortedParallelMatchesFromSorted)
+{
+    std::vector<std::string> values;
+    for (int i = 100000; i < 130000; ++i)
+    {
+        values.push_back(std::to_string(i));
+    }
+
+    auto sequential{avl_tree<std::string>::from_sorted(std::begin(values), std::end(values))};
+    for (std::size_t threads : {1, 3, 8})
+    {
+        auto parallel{avl_tree<std::string>::from_sorted_parallel(std::begin(values), std::end(values), threads)};
+        EXPECT_EQ(parallel.size(), values.size());
+        EXPECT_EQ(std::equal(std::begin(parallel), std::end(parallel), std::begin(sequential), std::end(sequential)), true);
+        EXPECT_EQ(parallel.contains("123456"), true);
+    }
+}
+
+// copying the value at index s_throwAt fails
+struct throwing_value
+{
+    static inline int s_throwAt{-1};
+
+    throwing_value(int v) : value{v} {}
+
+    throwing_value(const throwing_value & other) :
+        value{other.value}
+    {
+        if (s_throwAt == value)
+        {
+            throw std::runtime_error("copy failed");
+        }
+    }
+
+    bool operator<(const throwing_value & rhs) const { return value < rhs.value; }
+
+    int value;
+};
+
+TEST(AvlTreeTests, TestFromSortedReleasesNodesWhenACopyThrows)
+{
+    std::vector<throwing_value> values;
+    for (int i = 0; i < 100; ++i)
+    {
+        values.emplace_back(i);
+    }
+
+    throwing_value::s_throwAt = 70;
+    EXPECT_THROW(avl_tree<throwing_value>::from_sorted(std::begin(values), std::end(values)), std::runtime_error);
+    EXPECT_THROW(avl_tree<throwing_value>::from_sorted_parallel(std::begin(values), std::end(values), 4), std::runtime_error);
+    throwing_value::s_throwAt = -1;
+}
+
+}//ds_avl_tree
+}//test
@@ -0,0 +1,46 @@
+#pragma once
+#include <string>
+#include <gtest/gtest.h>
+#include "bloom_filter.h"
+
+namespace test
+{
+namespace ds_bloom_filter
+{
+
+TEST(BloomFilterTests, TestNoFalseNegatives)
+{
+    ds::bloom_filter<uint64_t> filter{10000};
+    for (uint64_t i = 0; i < 10000; ++i)
+    {
+        filter.insert(i * 7919);
+    }
+    for (uint64_t i = 0; i < 10000; ++i)
+    {
+        EXPECT_EQ(filter.contains(i * 7919), true);
+    }
+}
+
+TEST(BloomFilterTests, TestFalsePositiveRateFollowsBitsPerKey)
+{
+    constexpr uint64_t keys{20000};
+    ds::bloom_filter<std::string> filter{keys, 10};
+    for (uint64_t i = 0; i < keys; ++i)
+    {
+        filter.insert(std::to_string(i));
+    }
+
+    uint64_t falsePositives{0};
+    for (uint64_t i = keys; i < 2 * keys; ++i)
+    {
+        falsePositives += filter.contains(std::to_string(i));
+    }
+    // about 1% is expected at 10 bits per key
+    EXPECT_LT(falsePositives, keys / 40);
+
+    filter.clear();
+    EXPECT_EQ(filter.contains(std::string{"1"}), false);
+}
+
+}//ds_bloom_filter
+}//test
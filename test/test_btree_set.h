@@ -0,0 +1,130 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "btree_set.h"
+
+namespace test
+{
+namespace ds_btree_set
+{
+
+// nodes of 64 bytes hold a handful of keys, so a few hundred keys already split and merge on several levels
+using small_btree = ds::btree_set<int, std::less<int>, std::allocator<int>, 64>;
+
+TEST(BtreeSetTests, TestInsertRemoveMatchStdSet)
+{
+    small_btree tree;
+    std::set<int> expected;
+    std::mt19937 generator{11};
+    for (int i = 0; i < 20000; ++i)
+    {
+        int key(generator() % 2000);
+        if (generator() % 3)
+        {
+            EXPECT_EQ(tree.insert(key), expected.insert(key).second);
+        }
+        else
+        {
+            EXPECT_EQ(tree.remove(key), 1 == expected.erase(key));
+        }
+
+        if (0 == i % 500)
+        {
+            ASSERT_EQ(tree.validate(), true);
+        }
+    }
+
+    ASSERT_EQ(tree.validate(), true);
+    EXPECT_EQ(tree.size(), expected.size());
+    EXPECT_EQ(std::vector<int>(std::begin(tree), std::end(tree)), std::vector<int>(std::begin(expected), std::end(expected)));
+
+    for (auto key : expected)
+    {
+        EXPECT_EQ(tree.remove(key), true);
+    }
+    EXPECT_EQ(tree.validate(), true);
+    EXPECT_EQ(tree.empty(), true);
+    EXPECT_EQ(tree.begin(), tree.end());
+}
+
+TEST(BtreeSetTests, TestFindAndRangeScan)
+{
+    small_btree tree;
+    for (int key = 0; key < 1000; key += 2)
+    {
+        tree.insert(key);
+    }
+
+    EXPECT_EQ(tree.contains(500), true);
+    EXPECT_EQ(tree.contains(501), false);
+    EXPECT_EQ(*tree.find(998), 998);
+    EXPECT_EQ(tree.find(-1), tree.end());
+    EXPECT_EQ(*tree.findMin(), 0);
+    EXPECT_EQ(*tree.findMax(), 998);
+
+    std::vector<int> range;
+    for (auto it = tree.lower_bound(101); it != tree.end() && *it < 121; ++it)
+    {
+        range.push_back(*it);
+    }
+    EXPECT_EQ(range, (std::vector<int>{102, 104, 106, 108, 110, 112, 114, 116, 118, 120}));
+    EXPECT_EQ(tree.lower_bound(999), tree.end());
+
+    std::vector<int> reversed;
+    for (auto it = tree.end(); it != tree.begin();)
+    {
+        reversed.push_back(*--it);
+    }
+    EXPECT_EQ(reversed.size(), 500);
+    EXPECT_EQ(reversed.front(), 998);
+    EXPECT_EQ(reversed.back(), 0);
+}
+
+TEST(BtreeSetTests, TestUnsignedKeysKeepTheirOrder)
+{
+    ds::btree_set<uint32_t> tree;
+    std::vector<uint32_t> keys{0, 1, 0x7fffffffu, 0x80000000u, 0xfffffffeu, 0xffffffffu, 5, 0x90000000u};
+    for (auto key : keys)
+    {
+        tree.insert(key);
+    }
+    for (auto key : keys)
+    {
+        EXPECT_EQ(tree.contains(key), true);
+    }
+    EXPECT_EQ(tree.contains(0x80000001u), false);
+    EXPECT_EQ(*tree.findMax(), 0xffffffffu);
+    EXPECT_EQ(std::is_sorted(std::begin(tree), std::end(tree)), true);
+}
+
+TEST(BtreeSetTests, TestCopyAndMove)
+{
+    ds::btree_set<std::string, std::less<std::string>, std::allocator<std::string>, 128> tree;
+    for (int i = 0; i < 300; ++i)
+    {
+        tree.insert(std::to_string(i));
+    }
+
+    auto copy{tree};
+    EXPECT_EQ(copy.validate(), true);
+    EXPECT_EQ(std::equal(std::begin(copy), std::end(copy), std::begin(tree), std::end(tree)), true);
+
+    copy.remove("42");
+    EXPECT_EQ(tree.contains("42"), true);
+
+    auto moved{std::move(copy)};
+    EXPECT_EQ(moved.size(), 299);
+    EXPECT_EQ(moved.validate(), true);
+    EXPECT_EQ(copy.empty(), true);
+
+    tree = moved;
+    EXPECT_EQ(tree.contains("42"), false);
+    EXPECT_EQ(tree.validate(), true);
+}
+
+}//ds_btree_set
+}//test
@@ -0,0 +1,125 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "concurrent_hash_table.h"
+
+namespace test
+{
+namespace ds_concurrent_hash_table
+{
+
+// counts the key comparisons, a stand in for the bucket load seen by lookups
+struct counting_equal
+{
+    static inline std::size_t calls{0};
+
+    bool operator()(uint64_t lhs, uint64_t rhs) const
+    {
+        ++calls;
+        return lhs == rhs;
+    }
+};
+
+template<typename BucketPolicy>
+using policy_set = ds::concurrent_unordered_set<uint64_t, 64, std::hash<uint64_t>, counting_equal, ds::vector<uint64_t>, BucketPolicy>;
+
+template<typename Set>
+class ShardedBucketPolicyTests : public ::testing::Test
+{};
+
+using ShardedBucketPolicySets = ::testing::Types<policy_set<ds::prime_bucket_policy>,
+                                                 policy_set<ds::power_of_two_bucket_policy>,
+                                                 policy_set<ds::fastrange_bucket_policy>>;
+TYPED_TEST_SUITE(ShardedBucketPolicyTests, ShardedBucketPolicySets);
+
+TYPED_TEST(ShardedBucketPolicyTests, TestShardKeysSpreadOverTheShardBuckets)
+{
+    constexpr uint64_t keyCount{64 * 1024};
+    TypeParam set;
+    set.reserve(keyCount);
+    for (uint64_t key = 0; key < keyCount; ++key)
+    {
+        EXPECT_EQ(set.insert(key), true);
+    }
+
+    // about one key per bucket: a hit should compare against a couple of keys at most
+    counting_equal::calls = 0;
+    for (uint64_t key = 0; key < keyCount; ++key)
+    {
+        EXPECT_EQ(set.contains(key), true);
+    }
+    EXPECT_LT(counting_equal::calls, 2 * keyCount);
+}
+
+TEST(ConcurrentUnorderedSetTests, TestSingleThreadedOperations)
+{
+    ds::concurrent_unordered_set<uint64_t, 4> set;
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(set.insert(i), true);
+    }
+    EXPECT_EQ(set.insert(uint64_t{3}), false);
+    EXPECT_EQ(set.size(), 1000);
+
+    EXPECT_EQ(set.remove(uint64_t{3}), true);
+    EXPECT_EQ(set.contains(uint64_t{3}), false);
+    EXPECT_EQ(set.contains(uint64_t{4}), true);
+
+    set.clear();
+    EXPECT_EQ(set.empty(), true);
+}
+
+TEST(ConcurrentUnorderedSetTests, TestConcurrentInsertAndLookup)
+{
+    constexpr uint64_t threadCount{8};
+    constexpr uint64_t keysPerThread{5000};
+    ds::concurrent_unordered_set<uint64_t, 16> set;
+    std::atomic<uint64_t> inserted{0};
+
+    std::vector<std::thread> threads;
+    for (uint64_t t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&set, &inserted, t](){
+            for (uint64_t i = 0; i < keysPerThread; ++i)
+            {
+                // each key is also raced for by the next thread: exactly one insert wins
+                for (auto key : {i * threadCount + t, i * threadCount + (t + 1) % threadCount})
+                {
+                    if (set.insert(key))
+                    {
+                        ++inserted;
+                    }
+                    EXPECT_EQ(set.contains(key), true);
+                }
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(inserted.load(), threadCount * keysPerThread);
+    EXPECT_EQ(set.size(), threadCount * keysPerThread);
+    for (uint64_t key = 0; key < threadCount * keysPerThread; ++key)
+    {
+        EXPECT_EQ(set.contains(key), true);
+    }
+}
+
+TEST(ConcurrentUnorderedSetTests, TestTransparentLookup)
+{
+    ds::concurrent_unordered_set<std::string, 8, ds::string_hash, std::equal_to<>> set;
+    set.insert(std::string_view{"alpha"});
+    EXPECT_EQ(set.contains(std::string_view{"alpha"}), true);
+    EXPECT_EQ(set.contains(std::string{"alpha"}), true);
+    EXPECT_EQ(set.remove(std::string_view{"alpha"}), true);
+    EXPECT_EQ(set.contains("alpha"), false);
+}
+
+}//ds_concurrent_hash_table
+}//test
@@ -0,0 +1,91 @@
+#pragma once
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <gtest/gtest.h>
+#include "flat_hash_table.h"
+
+namespace test
+{
+namespace ds_flat_hash_table
+{
+
+TEST(FlatHashSetTests, TestInsertContainsRemove)
+{
+    ds::flat_unordered_set<int> set;
+    EXPECT_EQ(set.empty(), true);
+    EXPECT_EQ(set.contains(3), false);
+
+    EXPECT_EQ(set.insert(3), true);
+    EXPECT_EQ(set.insert(3), false);
+    EXPECT_EQ(set.size(), 1);
+    EXPECT_EQ(set.contains(3), true);
+
+    EXPECT_EQ(set.remove(3), true);
+    EXPECT_EQ(set.remove(3), false);
+    EXPECT_EQ(set.contains(3), false);
+    EXPECT_EQ(set.empty(), true);
+}
+
+TEST(FlatHashSetTests, TestGrowthAndTombstones)
+{
+    ds::flat_unordered_set<uint64_t> set;
+    std::unordered_set<uint64_t> reference;
+    std::mt19937_64 generator{42};
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        auto key{generator() % 5000};
+        if (generator() % 3 == 0)
+        {
+            EXPECT_EQ(set.remove(key), reference.erase(key) == 1);
+        }
+        else
+        {
+            EXPECT_EQ(set.insert(key), reference.insert(key).second);
+        }
+    }
+
+    ASSERT_EQ(set.size(), reference.size());
+    for (uint64_t key = 0; key < 5000; ++key)
+    {
+        EXPECT_EQ(set.contains(key), reference.count(key) == 1);
+    }
+
+    std::size_t visited{0};
+    for (auto key : set)
+    {
+        EXPECT_EQ(reference.count(key), 1);
+        ++visited;
+    }
+    EXPECT_EQ(visited, reference.size());
+}
+
+TEST(FlatHashSetTests, TestStringKeysCopyAndMove)
+{
+    ds::flat_unordered_set<std::string> set;
+    for (int i = 0; i < 100; ++i)
+    {
+        set.insert(std::to_string(i));
+    }
+
+    auto copy{set};
+    auto moved{std::move(set)};
+    EXPECT_EQ(copy.size(), 100);
+    EXPECT_EQ(moved.size(), 100);
+    EXPECT_EQ(moved.contains("42"), true);
+    EXPECT_EQ(copy.contains("99"), true);
+    EXPECT_EQ(copy.contains("100"), false);
+
+    copy.clear();
+    EXPECT_EQ(copy.empty(), true);
+    EXPECT_EQ(copy.contains("42"), false);
+    EXPECT_EQ(copy.insert("42"), true);
+
+    set.clear();
+    EXPECT_EQ(set.empty(), true);
+    EXPECT_EQ(set.contains("42"), false);
+}
+
+}//ds_flat_hash_table
+}//test
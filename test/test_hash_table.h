@@ -0,0 +1,410 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <gtest/gtest.h>
+#include "hash_table.h"
+
+namespace test
+{
+namespace ds_hash_table
+{
+
+struct counting_hash
+{
+    static inline std::size_t calls{0};
+
+    std::size_t operator()(const std::string & key) const
+    {
+        ++calls;
+        return std::hash<std::string>{}(key);
+    }
+};
+
+// counts the key comparisons, to check which lookups reach a bucket
+struct counting_equal
+{
+    static inline std::size_t calls{0};
+
+    bool operator()(uint64_t lhs, uint64_t rhs) const
+    {
+        ++calls;
+        return lhs == rhs;
+    }
+};
+
+// sends every key to the same bucket whatever the bucket count
+struct same_bucket_hash
+{
+    std::size_t operator()(uint64_t key) const
+    {
+        return static_cast<std::size_t>(key) << 32;
+    }
+};
+
+// counts how many values were built, to check try_emplace only builds on a miss
+struct counted_value
+{
+    static inline int constructions{0};
+
+    explicit counted_value(int v) :
+        value{v}
+    {
+        ++constructions;
+    }
+
+    int value;
+};
+
+template<typename BucketPolicy>
+using policy_set = ds::unordered_set<uint64_t, std::hash<uint64_t>, std::equal_to<uint64_t>, ds::vector<uint64_t>, BucketPolicy>;
+
+template<typename Set>
+class BucketPolicyTests : public ::testing::Test
+{};
+
+using BucketPolicySets = ::testing::Types<policy_set<ds::prime_bucket_policy>,
+                                          policy_set<ds::power_of_two_bucket_policy>,
+                                          policy_set<ds::fastrange_bucket_policy>>;
+TYPED_TEST_SUITE(BucketPolicyTests, BucketPolicySets);
+
+TYPED_TEST(BucketPolicyTests, TestInsertContainsRemoveAcrossRehash)
+{
+    TypeParam set;
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(set.insert(i << 12), true);
+    }
+    EXPECT_EQ(set.insert(uint64_t{5} << 12), false);
+
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(set.contains(i << 12), true);
+        EXPECT_EQ(set.contains((i << 12) + 1), false);
+    }
+
+    EXPECT_EQ(set.remove(uint64_t{5} << 12), true);
+    EXPECT_EQ(set.contains(uint64_t{5} << 12), false);
+}
+
+TYPED_TEST(BucketPolicyTests, TestZeroBucketsStillInserts)
+{
+    TypeParam set{0};
+    EXPECT_GT(set.bucket_count(), 0);
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(set.insert(i), true);
+    }
+    EXPECT_EQ(set.size(), 100);
+    EXPECT_EQ(set.contains(uint64_t{42}), true);
+    EXPECT_EQ(set.contains(uint64_t{100}), false);
+}
+
+TEST(BucketPolicyTests, TestReductionStaysInRange)
+{
+    for (std::size_t hash : {std::size_t{0}, std::size_t{1}, std::size_t{4096}, ~std::size_t{0}})
+    {
+        EXPECT_LT(ds::prime_bucket_policy::index(hash, 101), 101);
+        EXPECT_LT(ds::power_of_two_bucket_policy::index(hash, 128), 128);
+        EXPECT_LT(ds::fastrange_bucket_policy::index(hash, 101), 101);
+    }
+}
+
+TEST(UnorderedSetTests, TestReserveRehashesOnce)
+{
+    ds::unordered_set<uint64_t> set;
+    set.reserve(5000);
+    auto bucketCount{set.bucket_count()};
+    EXPECT_GT(bucketCount, 5000);
+
+    for (uint64_t i = 0; i < 5000; ++i)
+    {
+        EXPECT_EQ(set.insert(i), true);
+    }
+    EXPECT_EQ(set.bucket_count(), bucketCount);
+    EXPECT_EQ(set.size(), 5000);
+
+    set.reserve(10);
+    EXPECT_EQ(set.bucket_count(), bucketCount);
+}
+
+TEST(UnorderedSetTests, TestRehashKeepsStringKeys)
+{
+    ds::small_bucket_unordered_set<std::string, 2> set{4};
+    for (int i = 0; i < 2000; ++i)
+    {
+        EXPECT_EQ(set.insert(std::to_string(i)), true);
+    }
+    EXPECT_EQ(set.size(), 2000);
+    for (int i = 0; i < 2000; ++i)
+    {
+        EXPECT_EQ(set.contains(std::to_string(i)), true);
+    }
+    EXPECT_EQ(set.contains(std::string{"2000"}), false);
+}
+
+TEST(UnorderedSetTests, TestIncrementalRehashKeepsKeysVisible)
+{
+    ds::incremental_unordered_set<uint64_t, 2> set{4};
+    bool sawMigration{false};
+    for (uint64_t i = 0; i < 4000; ++i)
+    {
+        EXPECT_EQ(set.insert(i), true);
+        EXPECT_EQ(set.insert(i / 2), false);
+        sawMigration = sawMigration || set.rehashing();
+
+        EXPECT_EQ(set.contains(i), true);
+        EXPECT_EQ(set.contains(i / 3), true);
+        EXPECT_EQ(set.contains(i + 1), false);
+    }
+    EXPECT_EQ(sawMigration, true);
+    EXPECT_EQ(set.size(), 4000);
+
+    for (uint64_t i = 0; i < 4000; i += 2)
+    {
+        EXPECT_EQ(set.remove(i), true);
+        EXPECT_EQ(set.remove(i), false);
+    }
+    for (uint64_t i = 0; i < 4000; ++i)
+    {
+        EXPECT_EQ(set.contains(i), 1 == i % 2);
+    }
+    EXPECT_EQ(set.size(), 2000);
+    EXPECT_EQ(set.rehashing(), false);
+}
+
+TEST(UnorderedSetTests, TestIncrementalRehashReserveAndClear)
+{
+    ds::incremental_unordered_set<std::string> set{4};
+    for (int i = 0; i < 100; ++i)
+    {
+        set.insert(std::to_string(i));
+    }
+    set.reserve(1000);
+    EXPECT_EQ(set.rehashing(), false);
+    EXPECT_EQ(set.contains(std::string{"42"}), true);
+
+    set.clear();
+    EXPECT_EQ(set.empty(), true);
+    EXPECT_EQ(set.contains(std::string{"42"}), false);
+    EXPECT_EQ(set.insert(std::string{"42"}), true);
+}
+
+TEST(UnorderedSetTests, TestCachedHashSkipsHasherOnRehash)
+{
+    ds::cached_hash_unordered_set<std::string, counting_hash> set{4};
+    counting_hash::calls = 0;
+    for (int i = 0; i < 3000; ++i)
+    {
+        EXPECT_EQ(set.insert(std::to_string(i)), true);
+    }
+    EXPECT_EQ(counting_hash::calls, 3000);
+
+    EXPECT_EQ(set.insert(std::string{"7"}), false);
+    for (int i = 0; i < 3000; ++i)
+    {
+        EXPECT_EQ(set.contains(std::to_string(i)), true);
+    }
+    EXPECT_EQ(set.contains(std::string{"3000"}), false);
+
+    EXPECT_EQ(set.remove(std::string{"7"}), true);
+    EXPECT_EQ(set.contains(std::string{"7"}), false);
+    EXPECT_EQ(set.size(), 2999);
+}
+
+TEST(UnorderedSetTests, TestTransparentLookup)
+{
+    ds::unordered_set<std::string, ds::string_hash, std::equal_to<>> set;
+    EXPECT_EQ(set.insert(std::string_view{"alpha"}), true);
+    EXPECT_EQ(set.insert("beta"), true);
+    EXPECT_EQ(set.insert(std::string{"alpha"}), false);
+
+    const char buffer[]{"GET /alpha HTTP/1.1"};
+    std::string_view path{buffer + 5, 5};
+    EXPECT_EQ(set.contains(path), true);
+    EXPECT_EQ(set.contains("beta"), true);
+    EXPECT_EQ(set.contains(std::string_view{"gamma"}), false);
+
+    EXPECT_EQ(set.remove(path), true);
+    EXPECT_EQ(set.contains(std::string{"alpha"}), false);
+    EXPECT_EQ(set.size(), 1);
+}
+
+TEST(UnorderedSetTests, TestTransparentLookupWithCachedHash)
+{
+    ds::cached_hash_unordered_set<std::string, ds::string_hash, std::equal_to<>> set{4};
+    for (int i = 0; i < 500; ++i)
+    {
+        EXPECT_EQ(set.insert(std::to_string(i)), true);
+    }
+    EXPECT_EQ(set.contains(std::string_view{"499"}), true);
+    EXPECT_EQ(set.contains(std::string_view{"500"}), false);
+    EXPECT_EQ(set.remove(std::string_view{"7"}), true);
+    EXPECT_EQ(set.remove("7"), false);
+}
+
+TEST(UnorderedSetTests, TestContainsBatchMatchesContains)
+{
+    ds::unordered_set<uint64_t> set;
+    for (uint64_t i = 0; i < 5000; i += 3)
+    {
+        set.insert(i);
+    }
+
+    // not a multiple of the batch window
+    constexpr std::size_t count{1001};
+    uint64_t keys[count];
+    bool results[count];
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        keys[i] = i * 5;
+    }
+    set.contains_batch(keys, count, results);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(results[i], set.contains(keys[i]));
+        EXPECT_EQ(results[i], 0 == keys[i] % 3 && keys[i] < 5000);
+    }
+}
+
+TEST(UnorderedSetTests, TestContainsBatchDuringIncrementalRehash)
+{
+    ds::incremental_unordered_set<std::string, 1, ds::string_hash, std::equal_to<>> set{4};
+    std::string_view keys[]{"0", "1", "17", "254", "255", "256", "1000"};
+    bool results[std::size(keys)];
+    for (int i = 0; i < 256; ++i)
+    {
+        set.insert(std::to_string(i));
+    }
+    EXPECT_EQ(set.rehashing(), true);
+
+    set.contains_batch(keys, std::size(keys), results);
+    for (std::size_t i = 0; i < std::size(keys); ++i)
+    {
+        EXPECT_EQ(results[i], i < 5);
+    }
+}
+
+TEST(UnorderedSetTests, TestFilteredSetOperations)
+{
+    ds::filtered_unordered_set<uint64_t> set{4};
+    for (uint64_t i = 0; i < 3000; i += 2)
+    {
+        EXPECT_EQ(set.insert(i), true);
+    }
+    EXPECT_EQ(set.insert(uint64_t{4}), false);
+
+    constexpr std::size_t count{3000};
+    uint64_t keys[count];
+    bool results[count];
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        keys[i] = i;
+        EXPECT_EQ(set.contains(i), 0 == i % 2);
+    }
+    set.contains_batch(keys, count, results);
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(results[i], 0 == i % 2);
+    }
+
+    EXPECT_EQ(set.remove(uint64_t{4}), true);
+    EXPECT_EQ(set.contains(uint64_t{4}), false);
+    set.clear();
+    EXPECT_EQ(set.contains(uint64_t{6}), false);
+}
+
+TEST(UnorderedSetTests, TestFilteredSetRejectsMissesBeforeTheBucket)
+{
+    constexpr uint64_t count{200};
+    ds::filtered_unordered_set<uint64_t, same_bucket_hash, counting_equal> set{count};
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        set.insert(i);
+    }
+
+    // without the filter every miss would compare against all the keys of the one bucket
+    std::size_t missesReachingTheBucket{0};
+    for (uint64_t i = count; i < 2 * count; ++i)
+    {
+        counting_equal::calls = 0;
+        EXPECT_EQ(set.contains(i), false);
+        missesReachingTheBucket += 0 != counting_equal::calls;
+    }
+    EXPECT_LT(missesReachingTheBucket, count / 20);
+
+    counting_equal::calls = 0;
+    EXPECT_EQ(set.contains(uint64_t{7}), true);
+    EXPECT_GT(counting_equal::calls, 0);
+}
+
+TEST(UnorderedMapTests, TestTryEmplaceBuildsOnlyOnMiss)
+{
+    ds::unordered_map<int, counted_value> map;
+    counted_value::constructions = 0;
+
+    auto [p_value, inserted] = map.try_emplace(1, 10);
+    EXPECT_EQ(inserted, true);
+    EXPECT_EQ(p_value->value, 10);
+    EXPECT_EQ(counted_value::constructions, 1);
+
+    auto [p_existing, insertedAgain] = map.try_emplace(1, 20);
+    EXPECT_EQ(insertedAgain, false);
+    EXPECT_EQ(p_existing->value, 10);
+    EXPECT_EQ(counted_value::constructions, 1);
+}
+
+TEST(UnorderedMapTests, TestInsertOrAssign)
+{
+    ds::unordered_map<std::string, std::string> map;
+    auto [p_value, inserted] = map.insert_or_assign("key", std::string{"first"});
+    EXPECT_EQ(inserted, true);
+    EXPECT_EQ(*p_value, "first");
+
+    std::tie(p_value, inserted) = map.insert_or_assign("key", std::string{"second"});
+    EXPECT_EQ(inserted, false);
+    EXPECT_EQ(*p_value, "second");
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST(UnorderedMapTests, TestLookupAcrossRehash)
+{
+    ds::unordered_map<uint64_t, uint64_t> map{4};
+    for (uint64_t i = 0; i < 3000; ++i)
+    {
+        map[i] = i * 3;
+    }
+    ++map[7];
+    EXPECT_EQ(map.size(), 3000);
+
+    for (uint64_t i = 0; i < 3000; ++i)
+    {
+        EXPECT_EQ(map.at(i), 7 == i ? 22 : i * 3);
+    }
+    EXPECT_EQ(map.find(3000), nullptr);
+    EXPECT_THROW(map.at(3000), std::out_of_range);
+
+    EXPECT_EQ(map.remove(7), true);
+    EXPECT_EQ(map.contains(7), false);
+    EXPECT_EQ(map.remove(7), false);
+}
+
+TEST(UnorderedMapTests, TestIncrementalTransparentCachedMap)
+{
+    using slot = std::pair<std::string, int>;
+    ds::unordered_map<std::string, int, ds::string_hash, std::equal_to<>, ds::vector<ds::hashed_value<slot>>,
+                      ds::power_of_two_bucket_policy, ds::incremental_rehash_policy<1>> map{4};
+    for (int i = 0; i < 1000; ++i)
+    {
+        map.try_emplace(std::to_string(i), i);
+        EXPECT_EQ(*map.find(std::string_view{"0"}), 0);
+    }
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(*map.find(std::string_view{std::to_string(i)}), i);
+    }
+    EXPECT_EQ(map.remove(std::string_view{"999"}), true);
+    EXPECT_EQ(map.find(std::string_view{"999"}), nullptr);
+}
+
+}//ds_hash_table
+}//test
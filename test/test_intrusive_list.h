@@ -0,0 +1,116 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "intrusive_list.h"
+
+namespace test
+{
+namespace ds_intrusive_list
+{
+
+struct connection
+{
+    explicit connection(int connectionId) : id{connectionId} {}
+
+    std::string name{"connection"};
+    int id;
+    ds::intrusive_list_hook hook;
+};
+
+using connection_list = ds::intrusive_list<connection, &connection::hook>;
+
+std::vector<int> ids(const connection_list & l)
+{
+    std::vector<int> result;
+    for (const auto & c : l)
+    {
+        result.push_back(c.id);
+    }
+    return result;
+}
+
+TEST(IntrusiveListTests, TestLinkWithoutCopies)
+{
+    std::vector<connection> connections;
+    for (int i = 0; i < 5; ++i)
+    {
+        connections.emplace_back(i);
+    }
+
+    connection_list l;
+    for (auto & c : connections)
+    {
+        l.push_back(c);
+    }
+    EXPECT_EQ(l.size(), 5);
+    EXPECT_EQ(&l.front(), &connections[0]);
+    EXPECT_EQ(&l.back(), &connections[4]);
+    EXPECT_EQ(connections[2].hook.is_linked(), true);
+
+    l.erase(connections[2]);
+    EXPECT_EQ(connections[2].hook.is_linked(), false);
+    EXPECT_EQ(ids(l), (std::vector<int>{0, 1, 3, 4}));
+
+    l.insert(l.iterator_to(connections[1]), connections[2]);
+    EXPECT_EQ(ids(l), (std::vector<int>{0, 2, 1, 3, 4}));
+
+    l.move_to_front(connections[4]);
+    l.pop_back();
+    EXPECT_EQ(ids(l), (std::vector<int>{4, 0, 2, 1}));
+    EXPECT_EQ(connections[3].hook.is_linked(), false);
+
+    auto it{l.erase(l.iterator_to(connections[0]))};
+    EXPECT_EQ(it->id, 2);
+    l.clear();
+    EXPECT_EQ(l.empty(), true);
+    EXPECT_EQ(connections[4].hook.is_linked(), false);
+}
+
+TEST(IntrusiveListTests, TestCopiedObjectStartsUnlinked)
+{
+    connection c{1};
+    connection_list l;
+    l.push_front(c);
+
+    auto copy{c};
+    EXPECT_EQ(copy.hook.is_linked(), false);
+    l.push_back(copy);
+    EXPECT_EQ(l.size(), 2);
+    l.clear();
+}
+
+TEST(IntrusiveListTests, TestMove)
+{
+    connection a{1};
+    connection b{2};
+    connection_list l1;
+    l1.push_back(a);
+    l1.push_back(b);
+
+    connection_list l2{std::move(l1)};
+    EXPECT_EQ(l1.empty(), true);
+    EXPECT_EQ(ids(l2), (std::vector<int>{1, 2}));
+
+    l1 = std::move(l2);
+    EXPECT_EQ(ids(l1), (std::vector<int>{1, 2}));
+    l1.pop_front();
+    EXPECT_EQ(&l1.front(), &b);
+    EXPECT_EQ(std::prev(l1.end())->id, 2);
+}
+
+#if DS_LIST_CHECKED
+TEST(IntrusiveListTests, TestLinkedHookIsRefused)
+{
+    connection c{1};
+    connection_list l1;
+    connection_list l2;
+    l1.push_back(c);
+    EXPECT_EQ(l2.insert(l2.end(), c), l2.end());
+    EXPECT_EQ(l2.empty(), true);
+    EXPECT_EQ(l1.size(), 1);
+}
+#endif
+
+}//ds_intrusive_list
+}//test
@@ -1,5 +1,9 @@
 #pragma once
+#include <algorithm>
 #include <list>
+#include <random>
+#include <string>
+#include <vector>
 #include <gtest/gtest.h>
 #include "list.h"
 
@@ -289,6 +293,124 @@ TEST_F(TestInitializedList, TestPopBack)
     EXPECT_EQ(it, l1_.end());
 }
 
+#if DS_LIST_CHECKED
+TEST(ListTests, TestIteratorOfAnotherListIsRejected)
+{
+    ds::list<int> l1{1, 2};
+    ds::list<int> l2{3};
+    l1.insert(l2.begin(), 5);
+    EXPECT_EQ(l1.size(), 2);
+    EXPECT_EQ(l2.size(), 1);
+
+    EXPECT_EQ(l1.erase(l2.begin()), l1.end());
+    EXPECT_EQ(l2.front(), 3);
+}
+#endif
+
+template<typename T>
+std::vector<T> toVector(ds::list<T> & l)
+{
+    return std::vector<T>(l.begin(), l.end());
+}
+
+TEST(ListTests, TestClearKeepsListUsable)
+{
+    ds::list<int> l{1, 2, 3};
+    l.clear();
+    EXPECT_EQ(l.begin(), l.end());
+    l.pushBack(4);
+    EXPECT_EQ(toVector(l), std::vector<int>{4});
+}
+
+TEST(ListTests, TestSplice)
+{
+    ds::list<int> l1{1, 2, 3};
+    ds::list<int> l2{10, 20, 30, 40};
+
+    l1.splice(std::next(l1.begin()), l2, std::next(l2.begin()));
+    EXPECT_EQ(toVector(l1), (std::vector<int>{1, 20, 2, 3}));
+    EXPECT_EQ(toVector(l2), (std::vector<int>{10, 30, 40}));
+
+    l1.splice(l1.end(), l2, l2.begin(), std::prev(l2.end()));
+    EXPECT_EQ(toVector(l1), (std::vector<int>{1, 20, 2, 3, 10, 30}));
+    EXPECT_EQ(l1.size(), 6);
+    EXPECT_EQ(l2.size(), 1);
+
+    l1.splice(l1.begin(), l2);
+    EXPECT_EQ(toVector(l1), (std::vector<int>{40, 1, 20, 2, 3, 10, 30}));
+    EXPECT_EQ(l2.empty(), true);
+
+    // within the same list
+    l1.splice(l1.begin(), l1, std::prev(l1.end()));
+    EXPECT_EQ(toVector(l1), (std::vector<int>{30, 40, 1, 20, 2, 3, 10}));
+    l1.splice(l1.end(), l1, l1.begin(), std::next(l1.begin(), 2));
+    EXPECT_EQ(toVector(l1), (std::vector<int>{1, 20, 2, 3, 10, 30, 40}));
+    EXPECT_EQ(l1.size(), 7);
+
+    // spliced nodes belong to their new list
+    l1.erase(std::find(l1.begin(), l1.end(), 40));
+    l2.pushBack(5);
+    EXPECT_EQ(l1.size(), 6);
+}
+
+TEST(ListTests, TestMergeIsStable)
+{
+    using item = std::pair<int, char>;
+    auto byKey = [](const item & lhs, const item & rhs){ return lhs.first < rhs.first; };
+    ds::list<item> l1{{1, 'a'}, {3, 'a'}, {5, 'a'}};
+    ds::list<item> l2{{0, 'b'}, {1, 'b'}, {3, 'b'}, {6, 'b'}, {7, 'b'}};
+
+    l1.merge(l2, byKey);
+    EXPECT_EQ(toVector(l1), (std::vector<item>{{0, 'b'}, {1, 'a'}, {1, 'b'}, {3, 'a'}, {3, 'b'},
+                                               {5, 'a'}, {6, 'b'}, {7, 'b'}}));
+    EXPECT_EQ(l1.size(), 8);
+    EXPECT_EQ(l2.empty(), true);
+    l2.pushBack({9, 'c'});
+    EXPECT_EQ(l2.size(), 1);
+}
+
+TEST(ListTests, TestSortMatchesStableSort)
+{
+    std::mt19937 generator{5};
+    for (int count : {0, 1, 2, 3, 17, 1000, 4099})
+    {
+        std::vector<std::pair<int, int>> values(count);
+        ds::list<std::pair<int, int>> l;
+        for (int i = 0; i < count; ++i)
+        {
+            values[i] = {static_cast<int>(generator() % 50), i};
+            l.pushBack(values[i]);
+        }
+
+        auto byKey = [](const auto & lhs, const auto & rhs){ return lhs.first < rhs.first; };
+        l.sort(byKey);
+        std::stable_sort(values.begin(), values.end(), byKey);
+        EXPECT_EQ(toVector(l), values);
+
+        std::vector<std::pair<int, int>> backwards(values.rbegin(), values.rend());
+        EXPECT_EQ((std::vector<std::pair<int, int>>(std::make_reverse_iterator(l.end()), std::make_reverse_iterator(l.begin()))), backwards);
+    }
+
+    ds::list<std::string> strings{"pear", "apple", "fig"};
+    strings.sort();
+    EXPECT_EQ(toVector(strings), (std::vector<std::string>{"apple", "fig", "pear"}));
+}
+
+TEST(ListTests, TestReverseAndUnique)
+{
+    ds::list<int> l{1, 1, 2, 3, 3, 3, 1};
+    EXPECT_EQ(l.unique(), 3);
+    EXPECT_EQ(toVector(l), (std::vector<int>{1, 2, 3, 1}));
+
+    l.reverse();
+    EXPECT_EQ(toVector(l), (std::vector<int>{1, 3, 2, 1}));
+    EXPECT_EQ(l.back(), 1);
+    EXPECT_EQ(*std::prev(l.end(), 2), 2);
+
+    EXPECT_EQ(l.unique([](int lhs, int rhs){ return lhs + 1 == rhs || lhs == rhs + 1; }), 1);
+    EXPECT_EQ(toVector(l), (std::vector<int>{1, 3, 1}));
+}
+
 TEST_F(TestInitializedList, TestPopFront)
 {
     l1_.popFront();
@@ -1,2 +1,14 @@
 #include "test_list.h"
 #include "test_vector.h"
+#include "test_small_vector.h"
+#include "test_flat_hash_table.h"
+#include "test_hash_table.h"
+#include "test_concurrent_hash_table.h"
+#include "test_rcu_hash_table.h"
+#include "test_bloom_filter.h"
+#include "test_pool_allocator.h"
+#include "test_unrolled_list.h"
+#include "test_intrusive_list.h"
+#include "test_avl_tree.h"
+#include "test_btree_set.h"
+#include "test_trace.h"
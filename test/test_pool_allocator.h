@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <gtest/gtest.h>
+#include "list.h"
+#include "pool_allocator.h"
+
+namespace test
+{
+namespace ds_pool_allocator
+{
+
+TEST(PoolAllocatorTests, TestFreedBlocksAreReused)
+{
+    ds::pool_allocator<uint64_t> alloc;
+    auto *p_first{alloc.allocate(1)};
+    auto *p_second{alloc.allocate(1)};
+    EXPECT_NE(p_first, p_second);
+
+    alloc.deallocate(p_first, 1);
+    EXPECT_EQ(alloc.allocate(1), p_first);
+    alloc.deallocate(p_first, 1);
+    alloc.deallocate(p_second, 1);
+}
+
+TEST(PoolAllocatorTests, TestBlocksAreCarvedContiguously)
+{
+    struct alignas(16) node
+    {
+        uint64_t values[3];
+    };
+
+    ds::pool_allocator<node, 8> alloc;
+    node *blocks[20];
+    for (auto & p_block : blocks)
+    {
+        p_block = alloc.allocate(1);
+        EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(p_block) % alignof(node));
+    }
+    // chunks of 8 blocks: consecutive allocations inside a chunk are adjacent
+    EXPECT_EQ(blocks[1], blocks[0] + 1);
+    EXPECT_EQ(blocks[7], blocks[0] + 7);
+
+    for (auto *p_block : blocks)
+    {
+        alloc.deallocate(p_block, 1);
+    }
+}
+
+TEST(PoolAllocatorTests, TestArraysAndCopiesShareThePool)
+{
+    ds::pool_allocator<uint32_t> alloc;
+    auto *p_array{alloc.allocate(64)};
+    p_array[63] = 5;
+    alloc.deallocate(p_array, 64);
+
+    ds::pool_allocator<uint64_t> rebound{alloc};
+    EXPECT_TRUE(rebound == alloc);
+    EXPECT_FALSE(ds::pool_allocator<uint32_t>{} == alloc);
+
+    auto *p_value{alloc.allocate(1)};
+    alloc.deallocate(p_value, 1);
+    // uint64_t does not fit in the uint32_t blocks of the shared pool
+    auto *p_large{rebound.allocate(1)};
+    *p_large = 7;
+    rebound.deallocate(p_large, 1);
+}
+
+TEST(PoolAllocatorTests, TestListWithPoolAllocator)
+{
+    using pool_list = ds::list<std::string, ds::pool_allocator<std::string>>;
+    pool_list l{"one", "two", "three"};
+    for (int i = 0; i < 5000; ++i)
+    {
+        l.pushBack(std::to_string(i));
+    }
+    EXPECT_EQ(l.size(), 5003);
+    EXPECT_EQ(l.front(), "one");
+    EXPECT_EQ(l.back(), "4999");
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        l.popFront();
+    }
+    EXPECT_EQ(l.front(), "1997");
+
+    pool_list copy{l};
+    EXPECT_EQ(copy.size(), l.size());
+    pool_list moved;
+    moved = std::move(copy);
+    EXPECT_EQ(moved.back(), "4999");
+    moved.swap(l);
+    EXPECT_EQ(l.size(), 3003);
+}
+
+}//ds_pool_allocator
+}//test
@@ -0,0 +1,124 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "rcu_hash_table.h"
+
+namespace test
+{
+namespace ds_rcu_hash_table
+{
+
+struct tracked
+{
+    static inline std::atomic<int> alive{0};
+
+    tracked() { ++alive; }
+    ~tracked() { --alive; }
+};
+
+TEST(EpochManagerTests, TestGuardDefersReclamation)
+{
+    ds::epoch_manager epochs;
+    tracked::alive = 0;
+    {
+        ds::epoch_manager::guard guard{epochs};
+        epochs.retire(new tracked{});
+        EXPECT_EQ(epochs.collect(), 1);
+        EXPECT_EQ(tracked::alive.load(), 1);
+
+        // a nested guard keeps the outer epoch
+        {
+            ds::epoch_manager::guard inner{epochs};
+        }
+        EXPECT_EQ(epochs.collect(), 1);
+    }
+    EXPECT_EQ(epochs.collect(), 0);
+    EXPECT_EQ(tracked::alive.load(), 0);
+}
+
+TEST(EpochManagerTests, TestDestructorFreesPending)
+{
+    tracked::alive = 0;
+    {
+        ds::epoch_manager epochs;
+        ds::epoch_manager::guard guard{epochs};
+        epochs.retire(new tracked{});
+        epochs.retire(new tracked{});
+        EXPECT_EQ(epochs.pending(), 2);
+    }
+    EXPECT_EQ(tracked::alive.load(), 0);
+}
+
+TEST(RcuUnorderedSetTests, TestSingleThreadedOperations)
+{
+    ds::epoch_manager epochs;
+    ds::rcu_unordered_set<uint64_t> set{4, epochs};
+    for (uint64_t i = 0; i < 2000; ++i)
+    {
+        EXPECT_EQ(set.insert(i), true);
+    }
+    EXPECT_EQ(set.insert(uint64_t{11}), false);
+    EXPECT_EQ(set.size(), 2000);
+    EXPECT_GT(set.bucket_count(), 2000);
+
+    for (uint64_t i = 0; i < 2000; i += 2)
+    {
+        EXPECT_EQ(set.remove(i), true);
+    }
+    for (uint64_t i = 0; i < 2000; ++i)
+    {
+        EXPECT_EQ(set.contains(i), 1 == i % 2);
+    }
+    EXPECT_EQ(set.size(), 1000);
+    EXPECT_EQ(epochs.collect(), 0);
+}
+
+TEST(RcuUnorderedSetTests, TestReadersDuringWrites)
+{
+    constexpr uint64_t stableKeys{1000};
+    constexpr uint64_t writtenKeys{4000};
+    ds::epoch_manager epochs;
+    ds::rcu_unordered_set<std::string> set{4, epochs};
+    for (uint64_t i = 0; i < stableKeys; ++i)
+    {
+        set.insert(std::to_string(i));
+    }
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r)
+    {
+        readers.emplace_back([&set, &done](){
+            while (!done.load(std::memory_order_relaxed))
+            {
+                for (uint64_t i = 0; i < stableKeys; i += 7)
+                {
+                    EXPECT_EQ(set.contains(std::to_string(i)), true);
+                }
+            }
+        });
+    }
+
+    for (uint64_t i = stableKeys; i < stableKeys + writtenKeys; ++i)
+    {
+        set.insert(std::to_string(i));
+        if (0 == i % 3)
+        {
+            set.remove(std::to_string(i));
+        }
+    }
+    done = true;
+    for (auto & reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(set.size(), stableKeys + writtenKeys - writtenKeys / 3);
+    EXPECT_EQ(epochs.collect(), 0);
+}
+
+}//ds_rcu_hash_table
+}//test
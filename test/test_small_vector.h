@@ -0,0 +1,96 @@
+#pragma once
+#include <string>
+#include <gtest/gtest.h>
+#include "small_vector.h"
+#include "hash_table.h"
+
+namespace test
+{
+namespace ds_small_vector
+{
+
+TEST(SmallVectorTests, TestInlineUntilCapacity)
+{
+    ds::small_vector<int, 4> v;
+    EXPECT_EQ(v.empty(), true);
+    EXPECT_EQ(v.capacity(), 4);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        v.push_back(i);
+    }
+    EXPECT_EQ(v.is_inline(), true);
+    EXPECT_EQ(v.size(), 4);
+
+    v.push_back(4);
+    EXPECT_EQ(v.is_inline(), false);
+    EXPECT_EQ(v.size(), 5);
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(v[i], i);
+    }
+}
+
+TEST(SmallVectorTests, TestInsertAndErase)
+{
+    ds::small_vector<std::string, 2> v{"b", "d"};
+    v.insert(v.begin(), "a");
+    v.insert(v.begin() + 2, "c");
+    ASSERT_EQ(v.size(), 4);
+    EXPECT_EQ(v[0], "a");
+    EXPECT_EQ(v[1], "b");
+    EXPECT_EQ(v[2], "c");
+    EXPECT_EQ(v[3], "d");
+
+    auto it = v.erase(v.begin() + 1);
+    EXPECT_EQ(*it, "c");
+    v.erase(v.begin(), v.begin() + 2);
+    ASSERT_EQ(v.size(), 1);
+    EXPECT_EQ(v.front(), "d");
+}
+
+TEST(SmallVectorTests, TestCopyAndMove)
+{
+    ds::small_vector<std::string, 2> inlineVector{"short"};
+    ds::small_vector<std::string, 2> spilledVector{"one", "two", "three"};
+
+    auto inlineCopy{inlineVector};
+    auto spilledCopy{spilledVector};
+    EXPECT_EQ(inlineCopy.front(), "short");
+    EXPECT_EQ(spilledCopy.back(), "three");
+
+    ds::small_vector<std::string, 2> inlineMoved{std::move(inlineVector)};
+    ds::small_vector<std::string, 2> spilledMoved{std::move(spilledVector)};
+    EXPECT_EQ(inlineMoved.is_inline(), true);
+    EXPECT_EQ(inlineMoved.front(), "short");
+    EXPECT_EQ(spilledMoved.size(), 3);
+    EXPECT_EQ(spilledMoved.back(), "three");
+    EXPECT_EQ(inlineVector.empty(), true);
+    EXPECT_EQ(spilledVector.empty(), true);
+
+    inlineMoved.swap(spilledMoved);
+    EXPECT_EQ(inlineMoved.size(), 3);
+    EXPECT_EQ(spilledMoved.front(), "short");
+}
+
+TEST(SmallVectorTests, TestAsHashTableBucket)
+{
+    ds::small_bucket_unordered_set<int, 2> set;
+    for (int i = 0; i < 300; ++i)
+    {
+        EXPECT_EQ(set.insert(i), true);
+    }
+    EXPECT_EQ(set.insert(7), false);
+
+    for (int i = 0; i < 300; ++i)
+    {
+        EXPECT_EQ(set.contains(i), true);
+    }
+    EXPECT_EQ(set.contains(300), false);
+
+    EXPECT_EQ(set.remove(7), true);
+    EXPECT_EQ(set.contains(7), false);
+}
+
+}//ds_small_vector
+}//test
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstring>
+#include <vector>
+#include <gtest/gtest.h>
+#include "trace.h"
+#include "avl_tree.h"
+#include "binary_heap.h"
+
+namespace test
+{
+namespace ds_trace
+{
+
+TEST(TraceTests, TestRingBufferKeepsTheLastEventsInOrder)
+{
+    using ring = ds::ring_buffer_trace<8>;
+    ring::clear();
+    for (std::int64_t i = 0; i < 20; ++i)
+    {
+        ring::record({"test", "event", i, -i});
+    }
+    EXPECT_EQ(ring::recorded(), 20);
+
+    std::vector<std::int64_t> firsts;
+    ring::for_each([&firsts](const ds::trace_event & event){ firsts.push_back(event.first); });
+    EXPECT_EQ(firsts, (std::vector<std::int64_t>{12, 13, 14, 15, 16, 17, 18, 19}));
+
+    ring::clear();
+    firsts.clear();
+    ring::for_each([&firsts](const ds::trace_event & event){ firsts.push_back(event.first); });
+    EXPECT_EQ(firsts.empty(), true);
+}
+
+TEST(TraceTests, TestAvlTreeRecordsRotations)
+{
+    using ring = ds::ring_buffer_trace<64>;
+    ring::clear();
+
+    avl_tree<int, std::less<int>, std::allocator<int>, ring> tree;
+    tree.insert(1);
+    tree.insert(2);
+    tree.insert(3);
+    EXPECT_EQ(tree.contains(2), true);
+    EXPECT_EQ(tree.size(), 3);
+
+    std::size_t inserts{0};
+    std::size_t rotations{0};
+    ring::for_each([&](const ds::trace_event & event){
+        inserts += 0 == std::strcmp(event.p_where, "avl_tree::insert");
+        rotations += 0 == std::strcmp(event.p_where, "avl_tree::rotateWithRightChild");
+    });
+    EXPECT_EQ(inserts, 3);
+    EXPECT_EQ(rotations, 1);
+}
+
+TEST(TraceTests, TestBinaryHeapRecordsEvents)
+{
+    using ring = ds::ring_buffer_trace<64>;
+    ring::clear();
+
+    binary_heap<int, std::less<int>, ring> heap;
+    for (int value : {5, 3, 8, 1, 9, 2})
+    {
+        heap.insert(value);
+    }
+    EXPECT_GT(ring::recorded(), 6);
+
+    std::vector<int> popped;
+    while (!heap.is_empty())
+    {
+        popped.push_back(heap.first()->get());
+        heap.pop();
+    }
+    EXPECT_EQ(popped, (std::vector<int>{1, 2, 3, 5, 8, 9}));
+}
+
+}//ds_trace
+}//test
@@ -0,0 +1,163 @@
+#pragma once
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "unrolled_list.h"
+
+namespace test
+{
+namespace ds_unrolled_list
+{
+
+template<typename L, typename R>
+void expectSameElements(const L & lhs, const R & rhs)
+{
+    EXPECT_EQ(lhs.size(), rhs.size());
+    EXPECT_TRUE(std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+}
+
+TEST(UnrolledListTests, TestPushAndPop)
+{
+    ds::unrolled_list<int, 4> l;
+    EXPECT_EQ(l.empty(), true);
+    for (int i = 0; i < 10; ++i)
+    {
+        l.push_back(i);
+    }
+    l.push_front(-1);
+    EXPECT_EQ(l.size(), 11);
+    EXPECT_EQ(l.front(), -1);
+    EXPECT_EQ(l.back(), 9);
+
+    l.pop_front();
+    l.pop_back();
+    EXPECT_EQ(l.front(), 0);
+    EXPECT_EQ(l.back(), 8);
+    expectSameElements(l, std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8});
+}
+
+TEST(UnrolledListTests, TestAppendFillsChunks)
+{
+    ds::unrolled_list<uint8_t> l;
+    for (int i = 0; i < 1000; ++i)
+    {
+        l.push_back(static_cast<uint8_t>(i));
+    }
+    EXPECT_EQ(l.chunk_count(), (1000 + l.chunk_capacity - 1) / l.chunk_capacity);
+}
+
+TEST(UnrolledListTests, TestIterationBothWays)
+{
+    ds::unrolled_list<std::string, 3> l{"a", "b", "c", "d", "e", "f", "g"};
+    std::string forward;
+    for (const auto & s : l)
+    {
+        forward += s;
+    }
+    EXPECT_EQ(forward, "abcdefg");
+
+    std::string backward;
+    for (auto it = l.end(); it != l.begin();)
+    {
+        backward += *--it;
+    }
+    EXPECT_EQ(backward, "gfedcba");
+
+    ds::unrolled_list<std::string, 3>::const_iterator it{l.begin()};
+    EXPECT_EQ(*it, "a");
+}
+
+TEST(UnrolledListTests, TestRandomInsertEraseMatchesStdList)
+{
+    ds::unrolled_list<std::string, 8> l;
+    std::list<std::string> reference;
+    std::mt19937 generator{11};
+
+    for (int i = 0; i < 4000; ++i)
+    {
+        auto position{reference.empty() ? 0 : generator() % (reference.size() + 1)};
+        auto it{l.begin()};
+        auto refIt{reference.begin()};
+        std::advance(it, position);
+        std::advance(refIt, position);
+
+        if (generator() % 3 != 0 || reference.end() == refIt)
+        {
+            auto value{std::to_string(i)};
+            EXPECT_EQ(*l.insert(it, value), value);
+            reference.insert(refIt, value);
+        }
+        else
+        {
+            auto next{l.erase(it)};
+            auto refNext{reference.erase(refIt)};
+            EXPECT_EQ(reference.end() == refNext, l.end() == next);
+            if (reference.end() != refNext)
+            {
+                EXPECT_EQ(*next, *refNext);
+            }
+        }
+    }
+    expectSameElements(l, reference);
+}
+
+TEST(UnrolledListTests, TestRangeInsertIntoFullChunk)
+{
+    ds::unrolled_list<int, 4> l{1, 2, 3, 4};
+    std::vector<int> values{10, 11, 12, 13, 14, 15};
+    auto it{l.insert(std::next(l.begin()), values.begin(), values.end())};
+    EXPECT_EQ(*it, 10);
+    expectSameElements(l, std::vector<int>{1, 10, 11, 12, 13, 14, 15, 2, 3, 4});
+}
+
+TEST(UnrolledListTests, TestEraseMergesSparseChunks)
+{
+    ds::unrolled_list<int, 8> l;
+    for (int i = 0; i < 64; ++i)
+    {
+        l.push_back(i);
+    }
+    EXPECT_EQ(l.chunk_count(), 8);
+
+    for (auto it = l.begin(); it != l.end();)
+    {
+        it = (0 == *it % 4) ? std::next(it) : l.erase(it);
+    }
+    EXPECT_EQ(l.size(), 16);
+    EXPECT_LT(l.chunk_count(), 8);
+    int expected{0};
+    for (auto value : l)
+    {
+        EXPECT_EQ(value, expected);
+        expected += 4;
+    }
+}
+
+TEST(UnrolledListTests, TestCopyMoveSwap)
+{
+    ds::unrolled_list<std::string, 4> l1{"a", "b", "c", "d", "e"};
+    auto l2{l1};
+    expectSameElements(l1, l2);
+
+    auto l3{std::move(l2)};
+    EXPECT_EQ(l2.empty(), true);
+    expectSameElements(l1, l3);
+
+    ds::unrolled_list<std::string, 4> l4{"x"};
+    l4.swap(l3);
+    EXPECT_EQ(l4.size(), 5);
+    EXPECT_EQ(l3.front(), "x");
+
+    l2 = l4;
+    l3 = std::move(l4);
+    expectSameElements(l2, l3);
+    l2.clear();
+    EXPECT_EQ(l2.begin() == l2.end(), true);
+    l2.push_back("y");
+    EXPECT_EQ(l2.back(), "y");
+}
+
+}//ds_unrolled_list
+}//test
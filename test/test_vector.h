@@ -2,6 +2,7 @@
 #include <vector>
 #include <gtest/gtest.h>
 #include "vector.h"
+#include "remap_allocator.h"
 
 namespace test
 {
@@ -277,6 +278,84 @@ TEST_F(TestInitializedVector, TestPopBack)
     EXPECT_EQ(v1_.back(), 7318);
 }
 
+TEST(VectorTests, TestGrowthPreservesElements)
+{
+    ds::vector<uint64_t> trivial;
+    ds::vector<std::string> nonTrivial;
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        trivial.push_back(i);
+        nonTrivial.push_back(std::to_string(i));
+    }
+
+    ASSERT_EQ(trivial.size(), 1000);
+    ASSERT_EQ(nonTrivial.size(), 1000);
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(trivial[i], i);
+        EXPECT_EQ(nonTrivial[i], std::to_string(i));
+    }
+}
+
+TEST(VectorTests, TestGrowthThroughReallocatingAllocator)
+{
+    // a 4 KiB threshold moves the buffer from malloc to mmap and then grows it with mremap
+    ds::vector<uint64_t, ds::remap_allocator<uint64_t, 4096>> v;
+    for (uint64_t i = 0; i < 16384; ++i)
+    {
+        v.push_back(i);
+    }
+    v.insert(v.begin() + 10, {7, 7, 7});
+
+    ASSERT_EQ(v.size(), 16387);
+    EXPECT_EQ(v[9], 9);
+    EXPECT_EQ(v[10], 7);
+    EXPECT_EQ(v[12], 7);
+    EXPECT_EQ(v[13], 10);
+    EXPECT_EQ(v.back(), 16383);
+}
+
+TEST(VectorTests, TestPositionalInsertAndErase)
+{
+    ds::vector<std::string> v{"b", "d"};
+    v.insert(v.begin(), "a");
+    v.insert(v.begin() + 2, "c");
+    v.insert(v.end(), {"e", "f", "g"});
+    v.insert(v.begin(), {"x", "y"});
+
+    std::vector<std::string> expected{"x", "y", "a", "b", "c", "d", "e", "f", "g"};
+    ASSERT_EQ(v.size(), expected.size());
+    for (unsigned i = 0; i < v.size(); ++i)
+    {
+        EXPECT_EQ(v[i], expected[i]);
+    }
+
+    v.erase(v.begin(), v.begin() + 2);
+    v.erase(v.begin() + 3);
+    expected = {"a", "b", "c", "e", "f", "g"};
+    ASSERT_EQ(v.size(), expected.size());
+    for (unsigned i = 0; i < v.size(); ++i)
+    {
+        EXPECT_EQ(v[i], expected[i]);
+    }
+}
+
+TEST(VectorTests, TestFrontInsertShiftsWholeTail)
+{
+    ds::vector<uint8_t> v;
+    v.reserve(64);
+    for (uint8_t i = 0; i < 32; ++i)
+    {
+        v.insert(v.begin(), i);
+    }
+
+    ASSERT_EQ(v.size(), 32);
+    for (unsigned i = 0; i < v.size(); ++i)
+    {
+        EXPECT_EQ(v[i], 31 - i);
+    }
+}
+
 }//ds_vector
 }//test
 